@@ -9,54 +9,64 @@ Actor::Actor()
 }
 
 Actor::Actor(const std::wstring& name, const std::wstring& id, int level, int max_hp, ActorType type)
-    : m_sName{ name }
-    , m_sID{ id }
-    , m_Level{ level }
-    , m_XP{ 0 }
-    , m_XPToNextLevel{ 200 }
-    , m_HP{ max_hp } // Set current HP to max HP
-    , m_MaxHP{ max_hp }, m_MP{0}, m_MaxMP{5}
-    , m_bDead{ false }
-    , m_eActorType{ type }
-    , m_mapEquipmentSlots{
-        {Stats::EquipSlots::WEAPON, nullptr},
-        {Stats::EquipSlots::HEADGEAR, nullptr},
-        {Stats::EquipSlots::CHEST_BODY, nullptr},
-        {Stats::EquipSlots::FOOTWEAR, nullptr},
-        {Stats::EquipSlots::RELIC, nullptr},
-    }
-    , m_Stats{ 10, 3, 5, 5, 7 } //test
+    : m_Entity{ World::GetInstance().CreateEntity(
+        NameComponent{ name, id },
+        LevelComponent{ level, 0, 200 },
+        HealthComponent{ max_hp, max_hp, false }, // Set current HP to max HP
+        ManaComponent{ 0, 5 },
+        ActorTypeComponent{ type },
+        EquipmentComponent{},
+        Stats{ 10, 3, 5, 5, 7 }) } //test
 {
 }
 
+Actor::~Actor()
+{
+    World::GetInstance().DestroyEntity(m_Entity);
+}
+
+const std::vector<std::wstring>& Actor::GetEquipSlotLabels()
+{
+    static const std::vector<std::wstring> labels{ L"Weapon", L"HeadGear", L"Armour", L"FootWear", L"Relic" };
+    return labels;
+}
+
+const std::vector<std::wstring>& Actor::GetStatLabels()
+{
+    static const std::vector<std::wstring> labels{ L"Attack: ", L"Strength", L"Intelligence", L"Speed ", L"WillPower" , L"Stamina" };
+    return labels;
+}
 
 void Actor::HealHP(int hp)
 {
-    m_HP += hp;
+    auto& health = Get<HealthComponent>();
+    health.hp += hp;
 
-    if (m_HP >= m_MaxHP)
-        m_HP = m_MaxHP;
+    if (health.hp >= health.maxHp)
+        health.hp = health.maxHp;
 }
 
 void Actor::TakeDamage(int hp)
 {
-    m_HP -= hp;
-    if (m_HP <= 0)
+    auto& health = Get<HealthComponent>();
+    health.hp -= hp;
+    if (health.hp <= 0)
     {
-        m_HP = 0;
-        m_bDead = true;
+        health.hp = 0;
+        health.dead = true;
     }
 }
 
 bool Actor::UseMP(int mp)
 {
-    if (mp > m_MP)
+    auto& mana = Get<ManaComponent>();
+    if (mp > mana.mp)
         return false;
 
-	m_MP -= mp;
+	mana.mp -= mp;
 
-    if (m_MP <= 0)
-        m_MP = 0;
+    if (mana.mp <= 0)
+        mana.mp = 0;
 
     return true;
 }
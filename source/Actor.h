@@ -1,61 +1,59 @@
 #pragma once
 #include <string>
 #include <vector>
-#include <unordered_map>
 #include "Stats.h"
 #include "Equipment.h"
+#include "ecs/World.h"
+#include "ecs/Components.h"
 #include <memory>
 
+/*
+* Keeps the accessors actors always had, the data itself lives in components of the actor's entity
+* so systems can iterate every actor, enemy and NPC without going through this class.
+*/
 class Actor
 {
 public:
-    enum class ActorType
-    {
-        WARRIOR = 0, MAGE, ASSASSIN, KNIGHT,
-    };
+    using ActorType = ::ActorType;
 
 private:
-    const std::vector<std::wstring> m_EquipmentSlotLabels{ L"Weapon", L"HeadGear", L"Armour", L"FootWear", L"Relic" };
-    const std::vector<std::wstring> m_StatLabels{ L"Attack: ", L"Strength", L"Intelligence", L"Speed ", L"WillPower" , L"Stamina" };
+    Entity m_Entity;
 
-protected:
-    std::wstring m_sName, m_sID;
-    int m_Level, m_XP, m_XPToNextLevel, m_HP, m_MaxHP;
-    int m_MP, m_MaxMP;
-
-    bool m_bDead;
-
-    ActorType m_eActorType;
-
-    std::unordered_map<Stats::EquipSlots, std::shared_ptr<Equipment>> m_mapEquipmentSlots;
-
-    Stats m_Stats;
+    template <typename T>
+    inline T& Get() const { return *World::GetInstance().GetComponent<T>(m_Entity); }
 
 public:
     Actor();
     Actor(const std::wstring& name, const std::wstring& id, int level, int max_hp, ActorType type = ActorType::WARRIOR);
 
-    ~Actor() = default;
+    // The actor owns its entity, so it can not be copied
+    Actor(const Actor&) = delete;
+    Actor& operator=(const Actor&) = delete;
+    ~Actor();
+
+    inline const Entity GetEntity() const { return m_Entity; }
 
-    inline const int GetHP() const { return m_HP; }
-    inline const int GetMaxHP() const { return m_MaxHP; }
+    inline const int GetHP() const { return Get<HealthComponent>().hp; }
+    inline const int GetMaxHP() const { return Get<HealthComponent>().maxHp; }
 
-    inline const std::vector<std::wstring>& GetEquipSlotLabels() const { return m_EquipmentSlotLabels; }
-    inline const std::vector<std::wstring>& GetStatLabels() const { return m_StatLabels; }
+    static const std::vector<std::wstring>& GetEquipSlotLabels();
+    static const std::vector<std::wstring>& GetStatLabels();
 
-    std::unordered_map < Stats::EquipSlots, std::shared_ptr<Equipment>>& GetEquippedItemSlots() { return m_mapEquipmentSlots; }
+    EquipmentComponent& GetEquippedItemSlots() { return Get<EquipmentComponent>(); }
 
-    Stats& GetStats() { return m_Stats; }
+    Stats& GetStats() { return Get<Stats>(); }
 
-    inline const bool IsDead() const { return m_bDead; }
-    inline const std::wstring& GetName() const { return m_sName; }
-    inline const std::wstring& GetID() const { return m_sID; }
+    inline const bool IsDead() const { return Get<HealthComponent>().dead; }
+    inline const std::wstring& GetName() const { return Get<NameComponent>().name.Get(); }
+    inline const std::wstring& GetID() const { return Get<NameComponent>().id.Get(); }
+    inline const InternedString GetIDHandle() const { return Get<NameComponent>().id; }
+    inline const ActorType GetActorType() const { return Get<ActorTypeComponent>().type; }
 
-    const int GetLevel() const { return m_Level; }
-    const int GetXP() const { return m_XP; }
-    const int GetMP() const { return m_MP; }
-    const int GetMaxMP() const { return m_MaxMP; }
-    const int GetXPToNextLevel() const { return m_XPToNextLevel; }
+    const int GetLevel() const { return Get<LevelComponent>().level; }
+    const int GetXP() const { return Get<LevelComponent>().xp; }
+    const int GetMP() const { return Get<ManaComponent>().mp; }
+    const int GetMaxMP() const { return Get<ManaComponent>().maxMp; }
+    const int GetXPToNextLevel() const { return Get<LevelComponent>().xpToNextLevel; }
 
     void HealHP(int hp);
     void TakeDamage(int hp);
@@ -1,19 +1,27 @@
 #include "Console.h"
 #include "Logger.h"
 #include <algorithm>
+#include <array>
 #include <vector>
 #include <cassert>
+#include "Profiler.h"
+#include "utility/PerformanceOverlay.h"
+#include "utility/Metrics.h"
+
+namespace
+{
+    Metric g_WriteCalls{ "Console::Write calls" };
+}
 
 bool Console::SetTextColour(int size, int x, int y, HANDLE handle, WORD colour)
 {
     COORD pos = { x, y };
 
-    std::vector<WORD> write(size, colour);
-
     DWORD written = 0;
     LPDWORD lpNumWritten = &written;
 
-    if (!WriteConsoleOutputAttribute(handle, &write[0], size, pos, lpNumWritten))
+    // Every cell gets the same colour, so there is no need to build an array of it
+    if (!FillConsoleOutputAttribute(handle, colour, size, pos, lpNumWritten))
     {
         TRPG_ERROR("Unable to change text colour! ");
         return false;
@@ -28,7 +36,7 @@ void Console::DrawBorder()
 }
 
 Console::Console()
-    : m_pScreen(nullptr)
+    : m_pScreen(nullptr), m_pOverlay(std::make_unique<PerformanceOverlay>())
 {
     // Initialize the screen buffer
     m_pScreen = std::make_unique<wchar_t[]>(BUFFER_SIZE);
@@ -91,9 +99,15 @@ void Console::ClearBuffer()
 
 }
 
-void Console::Write(int x, int y, const std::wstring& text, WORD colour)
+void Console::Write(int x, int y, std::wstring_view text, WORD colour)
 {
-    std::vector<wchar_t> invalidCharacters{ L' ', L'\n', L'\t', L'\r' };
+    g_WriteCalls.Add();
+    WriteToBuffer(x, y, text, colour);
+}
+
+void Console::WriteToBuffer(int x, int y, std::wstring_view text, WORD colour)
+{
+    static constexpr std::array<wchar_t, 4> invalidCharacters{ L' ', L'\n', L'\t', L'\r' };
 
     auto is_any_of = [&](wchar_t character) {
         if (text.size() > 1)
@@ -111,19 +125,24 @@ void Console::Write(int x, int y, const std::wstring& text, WORD colour)
 
     int pos = y * SCREEN_WIDTH + x;
 
-    assert(pos + text.size() < BUFFER_SIZE);
+    assert(pos + text.size() <= BUFFER_SIZE);
 
-    if (pos + text.size() >= BUFFER_SIZE)
+    if (pos + text.size() > BUFFER_SIZE)
     {
         TRPG_ERROR("This is beyond the buffer size!");
+        return;
     }
 
-    swprintf(&m_pScreen[pos], BUFFER_SIZE, text.c_str());
+    // Copy the text as is, it is not a format string and does not need a terminator
+    std::copy(text.begin(), text.end(), &m_pScreen[pos]);
 }
 
 void Console::Draw()
 {
+    TRPG_PROFILE_SCOPE("Console::Draw");
+
     DrawBorder();
+    m_pOverlay->Draw(*this);
 
     WriteConsoleOutputCharacter(m_hConsole, m_pScreen.get(), BUFFER_SIZE, { 0, 0 }, &m_BytesWritten);
 }
@@ -4,6 +4,9 @@
 #include <Windows.h>
 #include <memory>
 #include <string>
+#include <string_view>
+
+class PerformanceOverlay;
 
 class Console
 {
@@ -21,10 +24,15 @@ private:
 
     DWORD m_BytesWritten;
     std::unique_ptr<wchar_t[]> m_pScreen;
+    std::unique_ptr<PerformanceOverlay> m_pOverlay;
 
     bool SetTextColour(int size, int x, int y, HANDLE handle, WORD colour);
     void DrawBorder();
 
+    // Write without counting the call, the overlay uses it so it does not show its own writes
+    void WriteToBuffer(int x, int y, std::wstring_view text, WORD colour);
+    friend class PerformanceOverlay;
+
 public:
     Console();
     ~Console();
@@ -35,7 +43,8 @@ public:
     const int GetHalfHeight() const { return HALF_HEIGHT; }
 
     void ClearBuffer();
-    void Write(int x, int y, const std::wstring& text, WORD color = WHITE);
+    inline PerformanceOverlay& GetOverlay() { return *m_pOverlay; }
+    void Write(int x, int y, std::wstring_view text, WORD color = WHITE);
     void Draw();
     bool ShowConsoleCursor(bool show);
     void DrawPanelHorz(int x, int y, size_t length, WORD colour = WHITE, const std::wstring& character = L"=");
@@ -2,21 +2,39 @@
 #include "Player.h"
 #include "Logger.h"
 
-Weapon::Weapon()
-	: Weapon(L"Weapon_Name", L"Weapon description", 0, 0)
+const WeaponProperties Equipment::NO_WEAPON_PROPERTIES{};
+const ArmourProperties Equipment::NO_ARMOUR_PROPERTIES{};
+
+Stats::EquipSlots Equipment::GetEquipSlot() const
 {
+	switch (GetType())
+	{
+	case EquipType::WEAPON:
+		return Stats::EquipSlots::WEAPON;
+	case EquipType::RELIC:
+		return Stats::EquipSlots::RELIC;
+	case EquipType::ARMOUR:
+		break;
+	default:
+		return Stats::EquipSlots::NO_SLOT;
+	}
+
+	switch (m_pDefinition->properties.armour.armourType)
+	{
+	case ArmourProperties::ArmourType::HEADGEAR:
+		return Stats::EquipSlots::HEADGEAR;
+	case ArmourProperties::ArmourType::CHEST_BODY:
+		return Stats::EquipSlots::CHEST_BODY;
+	case ArmourProperties::ArmourType::FOOTWEAR:
+		return Stats::EquipSlots::FOOTWEAR;
+	default:
+		return Stats::EquipSlots::NO_SLOT;
+	}
 }
 
-Weapon::Weapon(const std::wstring& name, const std::wstring& description, int buy_price, WeaponProperties weapon_properties, StatModifier stat_modifier)
+Weapon::Weapon(const Definition& definition)
+	: Equipment(definition)
 {
-	m_sName = name;
-	m_sDescription = description;
-	m_BuyPrice = buy_price;
-	m_SellPrice = buy_price / 2;
-	m_StatModifier = stat_modifier;
-	SetEquipType(EquipType::WEAPON);
-	m_WeaponProperties = weapon_properties;
-	m_ArmourProperties = ArmourProperties();
 }
 
 bool Weapon::OnEquip(Player& player)
@@ -28,12 +46,11 @@ bool Weapon::OnEquip(Player& player)
 
 	const auto& stat_modifier = GetStatModifier();
 
-	if (stat_modifier.modifierType != StatModifier::ModifierType::NO_TYPE)
-		player_stats.SetModifier(stat_modifier.modifierTypeStr, stat_modifier.statModifierVal);
+	if (stat_modifier.statId != StatId::NUM_STATS)
+		player_stats.AddModifier(m_ModifierSource, stat_modifier.statId, stat_modifier.statModifierVal);
 
 	Equip();
-
-	player_stats.UpdateStats();
+	player.GetInventory().OnEquippedChanged(GetDefinition().id);
 
 	return true;
 }
@@ -43,34 +60,17 @@ bool Weapon::OnRemove(Player& player)
 	auto& player_stats = player.GetStats();
 	player_stats.SetEquipmentValue(Stats::EquipSlots::WEAPON, 0);
 
-	const auto& stat_modifier = GetStatModifier();
-
-	if (stat_modifier.modifierType != StatModifier::ModifierType::NO_TYPE)
-		player_stats.SetModifier(stat_modifier.modifierTypeStr, 0);
+	player_stats.RemoveModifiers(m_ModifierSource);
 
 	Remove();
-
-	player_stats.UpdateStats();
+	player.GetInventory().OnEquippedChanged(GetDefinition().id);
 
 	return true;
 }
 
-Armour::Armour()
-	: Armour(L"Armour_name", L"Armour Description", 0, 0)
+Armour::Armour(const Definition& definition)
+	: Equipment(definition)
 {
-
-}
-
-Armour::Armour(const std::wstring& name, const std::wstring& description, int buy_price, ArmourProperties armour_properties, StatModifier stat_modifier)
-{
-	m_sName = name;
-	m_sDescription = description;
-	m_BuyPrice = buy_price;
-	m_SellPrice = buy_price / 2;
-	m_StatModifier = stat_modifier;
-	SetEquipType(EquipType::WEAPON);
-	m_WeaponProperties = WeaponProperties();
-	m_ArmourProperties = armour_properties;
 }
 
 bool Armour::OnEquip(Player& player)
@@ -78,36 +78,19 @@ bool Armour::OnEquip(Player& player)
 	const auto& item_pwr = GetValue();
 	auto& player_stats = player.GetStats();
 
-	Stats::EquipSlots slot = Stats::EquipSlots::NO_SLOT;
-	switch (m_ArmourProperties.armourType)
-	{
-	case ArmourProperties::ArmourType::HEADGEAR:
-			slot = Stats::EquipSlots::HEADGEAR;
-			break;
-	case ArmourProperties::ArmourType::CHEST_BODY:
-		slot = Stats::EquipSlots::CHEST_BODY;
-		break;
-	case ArmourProperties::ArmourType::FOOTWEAR:
-		slot = Stats::EquipSlots::FOOTWEAR;
-		break;
-	case ArmourProperties::ArmourType::NOT_ARMOUR:
-		slot = Stats::EquipSlots::NO_SLOT;
-		return false;
-	default:
-		slot = Stats::EquipSlots::NO_SLOT;
+	const Stats::EquipSlots slot = GetEquipSlot();
+	if (slot == Stats::EquipSlots::NO_SLOT)
 		return false;
-	}
 
 	const auto& stat_modifier = GetStatModifier();
 
-	if (stat_modifier.modifierType != StatModifier::ModifierType::NO_TYPE)
-		player_stats.SetModifier(stat_modifier.modifierTypeStr, stat_modifier.statModifierVal);
+	if (stat_modifier.statId != StatId::NUM_STATS)
+		player_stats.AddModifier(m_ModifierSource, stat_modifier.statId, stat_modifier.statModifierVal);
 
 	player_stats.SetEquipmentValue(slot, item_pwr);
 
 	Equip();
-
-	player_stats.UpdateStats();
+	player.GetInventory().OnEquippedChanged(GetDefinition().id);
 
 	return true;
 }
@@ -116,36 +99,16 @@ bool Armour::OnRemove(Player& player)
 {
 	auto& player_stats = player.GetStats();
 
-	Stats::EquipSlots slot = Stats::EquipSlots::NO_SLOT;
-	switch (m_ArmourProperties.armourType)
-	{
-	case ArmourProperties::ArmourType::HEADGEAR:
-		slot = Stats::EquipSlots::HEADGEAR;
-		break;
-	case ArmourProperties::ArmourType::CHEST_BODY:
-		slot = Stats::EquipSlots::CHEST_BODY;
-		break;
-	case ArmourProperties::ArmourType::FOOTWEAR:
-		slot = Stats::EquipSlots::FOOTWEAR;
-		break;
-	case ArmourProperties::ArmourType::NOT_ARMOUR:
-		slot = Stats::EquipSlots::NO_SLOT;
-		return false;
-	default:
-		slot = Stats::EquipSlots::NO_SLOT;
+	const Stats::EquipSlots slot = GetEquipSlot();
+	if (slot == Stats::EquipSlots::NO_SLOT)
 		return false;
-	}
 
-	const auto& stat_modifier = GetStatModifier();
-
-	if (stat_modifier.modifierType != StatModifier::ModifierType::NO_TYPE)
-		player_stats.SetModifier(stat_modifier.modifierTypeStr, 0);
+	player_stats.RemoveModifiers(m_ModifierSource);
 
 	player_stats.SetEquipmentValue(slot, 0);
 
 	Remove();
-
-	player_stats.UpdateStats();
+	player.GetInventory().OnEquippedChanged(GetDefinition().id);
 
 	return true;
 	
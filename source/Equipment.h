@@ -1,52 +1,59 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include "Stats.h"
+#include "utility/StringTable.h"
 
 class Player;
 
 struct StatModifier {
-    enum class ModifierType { STRENGTH, SPEED, INTELLIGENCE, WILLPOWER, ELEMENTAL, STAMINA,NO_TYPE };
-    enum class ElementalType { FIRE = 0, EARTH, WIND, ICE, WATER, LIGHTNING, NO_TYPE };
+    enum class ModifierType : uint8_t { STRENGTH, SPEED, INTELLIGENCE, WILLPOWER, ELEMENTAL, STAMINA,NO_TYPE };
+    enum class ElementalType : uint8_t { FIRE = 0, EARTH, WIND, ICE, WATER, LIGHTNING, NO_TYPE };
+
+    // Display names, indexed by ModifierType
+    static constexpr std::array<std::wstring_view, 7> TYPE_NAMES{
+        L"Strength", L"Speed", L"Intelligence", L"Dexterity", L"Elemental", L"Stamina", L"No Type"
+    };
 
     int statModifierVal;
     ModifierType modifierType;
     ElementalType elementalType;
-    std::wstring modifierTypeStr;
+    // The stat this modifies, StatId::NUM_STATS for elemental and untyped modifiers
+    StatId statId;
 
     StatModifier(int val = 0, ModifierType mod_type = ModifierType::NO_TYPE, ElementalType elemental_type = ElementalType::NO_TYPE)
-        : statModifierVal(val), modifierType(mod_type), elementalType(elemental_type) {
+        : statModifierVal(val), modifierType(mod_type), elementalType(elemental_type), statId(StatId::NUM_STATS) {
 
         switch (mod_type) {
         case ModifierType::STRENGTH:
-            modifierTypeStr = L"Strength";
+            statId = StatId::STRENGTH;
             break;
         case ModifierType::SPEED:
-            modifierTypeStr = L"Speed";
+            statId = StatId::SPEED;
             break;
         case ModifierType::INTELLIGENCE:
-            modifierTypeStr = L"Intelligence";
+            statId = StatId::INTELLIGENCE;
             break;
         case ModifierType::WILLPOWER:
-            modifierTypeStr = L"Dexterity";
-            break;
-        case ModifierType::ELEMENTAL:
-            modifierTypeStr = L"Elemental";
+            statId = StatId::WILLPOWER;
             break;
         case ModifierType::STAMINA:
-            modifierTypeStr = L"Stamina";
-            break;
-        case ModifierType::NO_TYPE:
-            modifierTypeStr = L"No Type";  // Fixed incorrect "L Strength"
+            statId = StatId::STAMINA;
             break;
         default:
             break;
         }
     }
+
+    inline const std::wstring_view GetTypeName() const { return TYPE_NAMES[static_cast<size_t>(modifierType)]; }
 };
 
 
 struct WeaponProperties {
-    enum class WeaponType { SWORD, DAGGER, BOW, STAFF, NOT_A_WEAPON };
+    enum class WeaponType : uint8_t { SWORD, DAGGER, BOW, STAFF, NOT_A_WEAPON };
 
     int attackPwr;
     WeaponType weaponType;
@@ -57,7 +64,7 @@ struct WeaponProperties {
 };
 
 struct ArmourProperties {
-    enum class ArmourType { HEADGEAR, CHEST_BODY, FOOTWEAR, NOT_ARMOUR };
+    enum class ArmourType : uint8_t { HEADGEAR, CHEST_BODY, FOOTWEAR, NOT_ARMOUR };
 
     int defensePwr;
     ArmourType armourType;
@@ -70,21 +77,38 @@ struct ArmourProperties {
 class Equipment
 {
 public:
-    enum class EquipType { WEAPON = 0, ARMOUR, RELIC, NO_TYPE };
+    enum class EquipType : uint8_t { WEAPON = 0, ARMOUR, RELIC, NO_TYPE };
+
+    // What every copy of a piece of equipment shares, owned by the ItemCatalog
+    struct Definition
+    {
+        uint32_t id{ 0 };
+        InternedString name, description;
+        EquipType type{ EquipType::NO_TYPE };
+        int buyPrice{ 0 }, sellPrice{ 0 }, weight{ 0 };
+        // Tagged by type, only weapons have weapon properties and only armour has armour properties
+        union
+        {
+            WeaponProperties weapon;
+            ArmourProperties armour;
+        } properties{ .weapon = WeaponProperties() };
+        StatModifier statModifier;
+    };
+
+    static constexpr int MAX_COUNT = 50;
 
 private:
-    const int MAX_COUNT = 50;
-    Equipment::EquipType m_eEquipType{ EquipType::NO_TYPE };
+    static const WeaponProperties NO_WEAPON_PROPERTIES;
+    static const ArmourProperties NO_ARMOUR_PROPERTIES;
 
 protected:
-    std::wstring m_sName{ L"" }, m_sDescription{ L"" };
-    int m_BuyPrice{ 0 }, m_SellPrice{ 0 }, m_Count{ 1 }, m_weight{ 0 };
+    const Definition* m_pDefinition;
+    int m_Count{ 1 };
+    // The modifiers this item applies while equipped are removed again through this handle
+    ModifierSource m_ModifierSource{ Stats::CreateModifierSource() };
     bool m_bEquipped{ false };
-    WeaponProperties m_WeaponProperties;
-    ArmourProperties m_ArmourProperties;
-    StatModifier m_StatModifier;
 
-    void SetEquipType(EquipType type) { m_eEquipType = type; }
+    explicit Equipment(const Definition& definition) : m_pDefinition{ &definition } {}
 
 public:
     virtual ~Equipment() {}
@@ -95,8 +119,10 @@ public:
     inline void Remove() { if (m_bEquipped) m_bEquipped = false; }
     inline void Equip() { if (!m_bEquipped) m_bEquipped = true; } // Fixed logic for Equip
     inline const bool IsEquipped() const { return m_bEquipped; }
-    inline const std::wstring& GetName() const { return m_sName; }
-    inline const std::wstring& GetDescription() const { return m_sDescription; } // Fixed typo in method name
+    inline const Definition& GetDefinition() const { return *m_pDefinition; }
+    inline const std::wstring& GetName() const { return m_pDefinition->name.Get(); }
+    inline const InternedString GetNameHandle() const { return m_pDefinition->name; }
+    inline const std::wstring& GetDescription() const { return m_pDefinition->description.Get(); } // Fixed typo in method name
     inline bool Add(int num = 1) 
     {
         if (num < 1)
@@ -124,12 +150,19 @@ public:
     }
 
     inline const int GetCount() const { return m_Count; }
-    inline const Equipment::EquipType GetType() const { return m_eEquipType; }
-    inline const WeaponProperties& GetWeaponProperties() const { return m_WeaponProperties; }
-    inline const ArmourProperties& GetArmourProperties() const { return m_ArmourProperties; }
-    inline const StatModifier& GetStatModifier() const { return m_StatModifier; }
-    inline const int GetBuyPrice() const { return m_BuyPrice;  }
-    inline const int GetSellPrice() const { return m_SellPrice;  }
+    inline const Equipment::EquipType GetType() const { return m_pDefinition->type; }
+    Stats::EquipSlots GetEquipSlot() const;
+    inline const WeaponProperties& GetWeaponProperties() const
+    {
+        return GetType() == EquipType::WEAPON ? m_pDefinition->properties.weapon : NO_WEAPON_PROPERTIES;
+    }
+    inline const ArmourProperties& GetArmourProperties() const
+    {
+        return GetType() == EquipType::ARMOUR ? m_pDefinition->properties.armour : NO_ARMOUR_PROPERTIES;
+    }
+    inline const StatModifier& GetStatModifier() const { return m_pDefinition->statModifier; }
+    inline const int GetBuyPrice() const { return m_pDefinition->buyPrice;  }
+    inline const int GetSellPrice() const { return m_pDefinition->sellPrice;  }
     inline const int GetMaxCount() const { return MAX_COUNT; }
 };
 
@@ -137,12 +170,10 @@ public:
 class Weapon : public Equipment
 {
 public:
-    Weapon();
-    Weapon(const std::wstring& name, const std::wstring& description, int buy_price, WeaponProperties weapon_properties = WeaponProperties(),
-        StatModifier stat_modifier = StatModifier());
+    explicit Weapon(const Definition& definition);
     ~Weapon() = default;
 
-    inline const int GetValue() const override { return m_WeaponProperties.attackPwr; }
+    inline const int GetValue() const override { return m_pDefinition->properties.weapon.attackPwr; }
     bool OnEquip(Player& player) override;
     bool OnRemove(Player& player) override;
 };
@@ -150,12 +181,10 @@ public:
 class Armour : public Equipment
 {
 public:
-    Armour();
-    Armour(const std::wstring& name, const std::wstring& description, int buy_price, ArmourProperties armour_properties = ArmourProperties(),
-        StatModifier stat_modifier = StatModifier());
+    explicit Armour(const Definition& definition);
     ~Armour() = default;
 
-    inline const int GetValue() const override { return m_ArmourProperties.defensePwr; }
+    inline const int GetValue() const override { return m_pDefinition->properties.armour.defensePwr; }
     bool OnEquip(Player& player) override;
     bool OnRemove(Player& player) override;
-};
\ No newline at end of file
+};
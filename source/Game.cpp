@@ -3,6 +3,11 @@
 #include "Logger.h"
 #include "states/GameState.h"
 #include "utility/Globals.h"
+#include "utility/Clock.h"
+#include "Profiler.h"
+#include "utility/PerformanceOverlay.h"
+#include "utility/StatFormula.h"
+#include "utility/ItemCatalog.h"
 
 bool Game::Init()
 {
@@ -20,6 +25,15 @@ bool Game::Init()
     m_pKeyboard = std::make_unique<Keyboard>();
     m_pStateMachine = std::make_unique<StateMachine>(); // Fixed variable name
 
+    // Loaded before any actor exists, the built in formulas are used if it fails
+    StatFormulas::GetInstance().LoadFile("./assets/xml_files/StatFormulas.xml");
+
+    // Every item definition is read once here, shops and inventories only point at them
+    ItemCatalog& catalog = ItemCatalog::GetInstance();
+    catalog.LoadItems("./assets/xml_files/itemDefs.xml");
+    catalog.LoadEquipment("./assets/xml_files/WeaponDefs.xml", true);
+    catalog.LoadEquipment("./assets/xml_files/AmourDefs.xml", false);
+
     m_pStateMachine->PushState(std::make_unique<GameState>(*m_pConsole, *m_pKeyboard, *m_pStateMachine));
 
     return true;
@@ -27,10 +41,12 @@ bool Game::Init()
 
 void Game::ProcessEvents()
 {
+    TRPG_PROFILE_SCOPE("Game::ProcessEvents");
+
     if (!GetNumberOfConsoleInputEvents(m_hConsoleIn, &m_NumRead))
     {
         DWORD error = GetLastError();
-        TRPG_ERROR("Unable to get console events: " + std::to_string(error));
+        TRPG_LOGF(LogLevel::ERR, LogCategory::INPUT, "Unable to get console events: {}", error);
         return;
     }
     if (m_NumRead <= 0)
@@ -39,7 +55,7 @@ void Game::ProcessEvents()
     if (!PeekConsoleInput(m_hConsoleIn, m_InRecBuf, 128, &m_NumRead))
     {
         DWORD error = GetLastError();
-        TRPG_ERROR("Failed to peek console input: " + std::to_string(error));
+        TRPG_LOGF(LogLevel::ERR, LogCategory::INPUT, "Failed to peek console input: {}", error);
         return;
     }
 
@@ -59,9 +75,14 @@ void Game::ProcessEvents()
 
 void Game::ProcessInputs()
 {
+    TRPG_PROFILE_SCOPE("Game::ProcessInputs");
+
     if (m_pKeyboard->IsKeyJustPressed(KEY_ESCAPE))
         m_bIsRunning = false;
 
+    if (m_pKeyboard->IsKeyJustPressed(KEY_F12))
+        m_pConsole->GetOverlay().Toggle();
+
     if (m_pStateMachine->Empty())
     {
         TRPG_ERROR("NO STATES TO PROCESS!");
@@ -74,6 +95,8 @@ void Game::ProcessInputs()
 
 void Game::Update()
 {
+    TRPG_PROFILE_SCOPE("Game::Update");
+
     if (m_pStateMachine->Empty())
     {
         TRPG_ERROR("NO STATES TO UPDATE!");
@@ -89,6 +112,8 @@ void Game::Update()
 
 void Game::Draw()
 {
+    TRPG_PROFILE_SCOPE("Game::Draw");
+
     if (m_pStateMachine->Empty())
     {
         TRPG_ERROR("NO STATES TO DRAW!");
@@ -130,11 +155,17 @@ void Game::Run()
 
     while (m_bIsRunning)
     {
+        // Everything in this tick reads the time sampled here
+        Clock::GetInstance().Tick();
+        m_pConsole->GetOverlay().Update();
+
         ProcessEvents();
         ProcessInputs();
         Update();
         Draw();
     }
 
+    TRPG_PROFILE_DUMP("trpg_profile.json");
+
     std::cout << "Bye Bye!\n";
 }
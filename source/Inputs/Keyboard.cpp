@@ -19,7 +19,7 @@ void Keyboard::OnKeyDown(int key)
 {
 	if (key > KEY_LAST)
 	{
-		TRPG_ERROR("[" + std::to_string(key) + "] - Is not defined!");
+		TRPG_LOGF(LogLevel::ERR, LogCategory::INPUT, "[{}] - Is not defined!", key);
 		return;
 	}
 	m_keys[key].Update(true);
@@ -29,7 +29,7 @@ void Keyboard::OnKeyUp(int key)
 {
 	if (key > KEY_LAST)
 	{
-		TRPG_ERROR("[" + std::to_string(key) + "] - Is not defined!");
+		TRPG_LOGF(LogLevel::ERR, LogCategory::INPUT, "[{}] - Is not defined!", key);
 		return;
 	}
 	m_keys[key].Update(false);
@@ -39,7 +39,7 @@ bool Keyboard::IsKeyHeld(int key) const
 {
 	if (key > KEY_LAST)
 	{
-		TRPG_ERROR("[" + std::to_string(key) + "] - Is not defined!");
+		TRPG_LOGF(LogLevel::ERR, LogCategory::INPUT, "[{}] - Is not defined!", key);
 		return false;
 	}
 	return m_keys[key].m_bIsDown;
@@ -49,7 +49,7 @@ bool Keyboard::IsKeyJustPressed(int key) const
 {
 	if (key > KEY_LAST)
 	{
-		TRPG_ERROR("[" + std::to_string(key) + "] - Is not defined!");
+		TRPG_LOGF(LogLevel::ERR, LogCategory::INPUT, "[{}] - Is not defined!", key);
 		return false;
 	}
 	return m_keys[key].m_bIsJustPressed;
@@ -59,7 +59,7 @@ bool Keyboard::IsKeyJustReleased(int key) const
 {
 	if (key > KEY_LAST)
 	{
-		TRPG_ERROR("[" + std::to_string(key) + "] - Is not defined!");
+		TRPG_LOGF(LogLevel::ERR, LogCategory::INPUT, "[{}] - Is not defined!", key);
 		return false;
 	}
 	return m_keys[key].m_bIsJustReleased;
@@ -1,10 +1,17 @@
 #pragma once
 
 constexpr int KEY_BACKSPACE = 0x08;
+constexpr int KEY_TAB = 0x09;
 constexpr int KEY_ENTER = 0x0D;
 constexpr int KEY_ESCAPE = 0x1B;
 constexpr int KEY_SPACE = 0x20;
 
+// Arrow Keys
+constexpr int KEY_LEFT = 0x25;
+constexpr int KEY_UP = 0x26;
+constexpr int KEY_RIGHT = 0x27;
+constexpr int KEY_DOWN = 0x28;
+
 
 // Numbers
 constexpr int KEY_0 = 0x30;
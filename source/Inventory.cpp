@@ -1,10 +1,77 @@
 #include "Inventory.h"
 #include "Logger.h"
 #include "utility/trpg_utilities.h"
+#include "utility/ItemCatalog.h"
+#include "utility/ItemCreator.h"
+
+void Inventory::CreateViews()
+{
+	auto by_name = [](const auto& lh, const auto& rh) { return lh->GetName() < rh->GetName(); };
+
+	// Item names come from GetItemName
+	m_ItemViews[static_cast<size_t>(InventorySort::NAME)] = ItemView{
+		[](const auto& lh, const auto& rh) { return lh->GetItemName() < rh->GetItemName(); } };
+	m_ItemViews[static_cast<size_t>(InventorySort::PRICE)] = ItemView{
+		[](const auto& lh, const auto& rh) { return lh->GetBuyPrice() < rh->GetBuyPrice(); } };
+	m_ItemViews[static_cast<size_t>(InventorySort::VALUE)] = ItemView{
+		[](const auto& lh, const auto& rh) { return lh->GetItemValue() < rh->GetItemValue(); } };
+
+	// Items have no slot, so they group by type in both views
+	auto item_type = [](const std::shared_ptr<Item>& item) { return static_cast<int>(item->GetType()); };
+	auto by_item_type = [item_type](const auto& lh, const auto& rh) {
+		if (item_type(lh) != item_type(rh))
+			return item_type(lh) < item_type(rh);
+		return lh->GetItemName() < rh->GetItemName();
+		};
+	m_ItemViews[static_cast<size_t>(InventorySort::SLOT)] = ItemView{ by_item_type, item_type };
+	m_ItemViews[static_cast<size_t>(InventorySort::TYPE)] = ItemView{ by_item_type, item_type };
+
+	m_EquipmentViews[static_cast<size_t>(InventorySort::NAME)] = EquipmentView{ by_name };
+	m_EquipmentViews[static_cast<size_t>(InventorySort::PRICE)] = EquipmentView{
+		[](const auto& lh, const auto& rh) { return lh->GetBuyPrice() < rh->GetBuyPrice(); } };
+	m_EquipmentViews[static_cast<size_t>(InventorySort::VALUE)] = EquipmentView{
+		[](const auto& lh, const auto& rh) { return lh->GetValue() < rh->GetValue(); } };
+
+	auto equip_slot = [](const std::shared_ptr<Equipment>& equipment) { return static_cast<int>(equipment->GetEquipSlot()); };
+	m_EquipmentViews[static_cast<size_t>(InventorySort::SLOT)] = EquipmentView{
+		[equip_slot, by_name](const auto& lh, const auto& rh) {
+			if (equip_slot(lh) != equip_slot(rh))
+				return equip_slot(lh) < equip_slot(rh);
+			return by_name(lh, rh);
+		},
+		equip_slot };
+
+	auto equip_type = [](const std::shared_ptr<Equipment>& equipment) { return static_cast<int>(equipment->GetType()); };
+	m_EquipmentViews[static_cast<size_t>(InventorySort::TYPE)] = EquipmentView{
+		[equip_type, by_name](const auto& lh, const auto& rh) {
+			if (equip_type(lh) != equip_type(rh))
+				return equip_type(lh) < equip_type(rh);
+			return by_name(lh, rh);
+		},
+		equip_type };
+
+	// Equipped entries can not be picked for a slot again, so they are left out until they come off
+	m_EquipmentBySlot = EquipmentIndex{ Stats::NUM_EQUIP_SLOTS, by_name,
+		[](const std::shared_ptr<Equipment>& equipment) { return equipment->IsEquipped() ? -1 : static_cast<int>(equipment->GetEquipSlot()); } };
+	m_EquipmentByType = EquipmentIndex{ static_cast<size_t>(Equipment::EquipType::NO_TYPE), by_name, equip_type };
+}
 
 Inventory::Inventory()
+	: m_ItemVersion{ 0 }, m_EquipmentVersion{ 0 }
+{
+	CreateViews();
+}
+
+std::shared_ptr<Item> Inventory::GetItem(Handle handle) const
 {
+	const auto* item = m_Items.Get(handle);
+	return item ? *item : nullptr;
+}
 
+std::shared_ptr<Equipment> Inventory::GetEquipment(Handle handle) const
+{
+	const auto* equipment = m_Equipment.Get(handle);
+	return equipment ? *equipment : nullptr;
 }
 
 bool Inventory::AddItem(std::shared_ptr<Item> newItem)
@@ -14,52 +81,323 @@ bool Inventory::AddItem(std::shared_ptr<Item> newItem)
 		return false;
 	}
 
-	for (auto& item : m_Items)
+	const uint32_t id = newItem->GetDefinition().id;
+
+	// Already have some, add to the stack
+	const Handle handle = m_Items.Find(id);
+	if (const auto* item = m_Items.Get(handle))
 	{
-		if (!item) {
-			Logger::Error("Found a null item in the inventory.");
-			continue;
-		}
+		if (!(*item)->AddItem(newItem->GetCount()))
+			return false;
 
-		if (item->GetItemName() == newItem->GetItemName())
-			return item->AddItem(newItem->GetCount());
+		m_ItemVersion++;
+		return true;
 	}
 
-	m_Items.push_back(newItem);
+	m_Items.Add(id, std::move(newItem));
+	m_ItemVersion++;
+
+	for (auto& view : m_ItemViews)
+		view.OnAdd(m_Items.GetEntries(), m_Items.Size() - 1);
+
 	return true;
 }
 
 bool Inventory::AddEquipment(std::shared_ptr<Equipment> newEquipment)
 {
-	for (auto& equip : m_Equipment)
+	if (!newEquipment) {
+		Logger::Error("Attempted to add null equipment to the inventory.");
+		return false;
+	}
+
+	const uint32_t id = newEquipment->GetDefinition().id;
+
+	const Handle handle = m_Equipment.Find(id);
+	if (const auto* equipment = m_Equipment.Get(handle))
 	{
-		if (equip->GetName() == newEquipment->GetName())
-			return equip->Add(newEquipment->GetCount());
+		if (!(*equipment)->Add(newEquipment->GetCount()))
+			return false;
+
+		m_EquipmentVersion++;
+		return true;
 	}
 
-	m_Equipment.push_back(std::move(newEquipment));
+	m_Equipment.Add(id, std::move(newEquipment));
+	m_EquipmentVersion++;
+
+	for (auto& view : m_EquipmentViews)
+		view.OnAdd(m_Equipment.GetEntries(), m_Equipment.Size() - 1);
 
-	return false;
+	m_EquipmentBySlot.OnAdd(m_Equipment.GetEntries(), m_Equipment.Size() - 1);
+	m_EquipmentByType.OnAdd(m_Equipment.GetEntries(), m_Equipment.Size() - 1);
+
+	return true;
+}
+
+bool Inventory::RemoveItem(Handle handle)
+{
+	const size_t last = m_Items.Size() - 1;
+	const size_t index = m_Items.Remove(handle);
+
+	if (index == m_Items.NO_INDEX)
+	{
+		TRPG_LOG_CAT(LogLevel::ERR, LogCategory::INVENTORY, "Failed to remove item, it is no longer in the inventory");
+		return false;
+	}
+
+	for (auto& view : m_ItemViews)
+		view.OnRemove(index, last);
+
+	m_ItemVersion++;
+	return true;
+}
+
+bool Inventory::RemoveEquipment(Handle handle)
+{
+	const size_t last = m_Equipment.Size() - 1;
+	const size_t index = m_Equipment.Remove(handle);
+
+	if (index == m_Equipment.NO_INDEX)
+	{
+		TRPG_LOG_CAT(LogLevel::ERR, LogCategory::INVENTORY, "Failed to remove equipment, it is no longer in the inventory");
+		return false;
+	}
+
+	for (auto& view : m_EquipmentViews)
+		view.OnRemove(index, last);
+
+	m_EquipmentBySlot.OnRemove(index, last);
+	m_EquipmentByType.OnRemove(index, last);
+
+	m_EquipmentVersion++;
+	return true;
+}
+
+void Inventory::OnEquippedChanged(uint32_t definition_id)
+{
+	const Handle handle = m_Equipment.Find(definition_id);
+	if (!m_Equipment.IsValid(handle))
+		return;
+
+	m_EquipmentBySlot.OnChanged(m_Equipment.GetEntries(), m_Equipment.GetIndex(handle));
+	m_EquipmentVersion++;
 }
 
 bool Inventory::UseItem(int index, Player& player)
 {
-	if (m_Items.empty())
+	if (m_Items.Empty())
 	{
 		TRPG_ERROR("Failed to use items");
 		return false;
 	}
 
-	if (index >= m_Items.size())
+	if (index < 0 || index >= m_Items.Size())
 	{
-		TRPG_ERROR("Failed to use item. Index is beyond Item size - INDEX[" + std::to_string(index) + "]");
+		TRPG_LOGF(LogLevel::ERR, LogCategory::INVENTORY, "Failed to use item. Index is beyond Item size - INDEX[{}]", index);
 		return false;
 	}
 
-	m_Items[index]->OnUse(player);
+	return UseItem(m_Items.GetHandle(index), player);
+}
 
-	if (m_Items[index]->GetCount() <= 0)
-		remove(m_Items, index);
+bool Inventory::UseItem(Handle handle, Player& player)
+{
+	const auto* item = m_Items.Get(handle);
+	if (!item)
+	{
+		TRPG_LOG_CAT(LogLevel::ERR, LogCategory::INVENTORY, "Failed to use item, it is no longer in the inventory");
+		return false;
+	}
+
+	(*item)->OnUse(player);
+
+	if ((*item)->GetCount() <= 0)
+		RemoveItem(handle);
+	else
+		m_ItemVersion++;
 
 	return true;
 }
+
+Transaction::Result Inventory::CanAdd(const Transaction& transaction) const
+{
+	if (transaction.Empty())
+		return Transaction::Result::EMPTY;
+
+	for (const auto& line : transaction.GetLines())
+	{
+		int count = line.count;
+
+		if (line.pItem)
+		{
+			// Some types have no class yet, the catalog loads them but they can not be held
+			if (!ItemCreator::CanCreateItem(*line.pItem))
+				return Transaction::Result::CAN_NOT_CREATE;
+
+			if (const auto* item = m_Items.Get(m_Items.Find(line.pItem->id)))
+				count += (*item)->GetCount();
+
+			if (count > Item::MAX_COUNT)
+				return Transaction::Result::STACK_FULL;
+		}
+		else
+		{
+			if (!ItemCreator::CanCreateEquipment(*line.pEquipment))
+				return Transaction::Result::CAN_NOT_CREATE;
+
+			if (const auto* equipment = m_Equipment.Get(m_Equipment.Find(line.pEquipment->id)))
+				count += (*equipment)->GetCount();
+
+			if (count > Equipment::MAX_COUNT)
+				return Transaction::Result::STACK_FULL;
+		}
+	}
+
+	return Transaction::Result::OK;
+}
+
+Transaction::Result Inventory::CanRemove(const Transaction& transaction) const
+{
+	if (transaction.Empty())
+		return Transaction::Result::EMPTY;
+
+	for (const auto& line : transaction.GetLines())
+	{
+		int available = 0;
+
+		if (line.pItem)
+		{
+			if (const auto* item = m_Items.Get(m_Items.Find(line.pItem->id)))
+				available = (*item)->GetCount();
+		}
+		else if (const auto* equipment = m_Equipment.Get(m_Equipment.Find(line.pEquipment->id)))
+		{
+			// The one being worn stays
+			available = (*equipment)->GetCount() - ((*equipment)->IsEquipped() ? 1 : 0);
+		}
+
+		if (line.count > available)
+			return Transaction::Result::NOT_ENOUGH_ITEMS;
+	}
+
+	return Transaction::Result::OK;
+}
+
+Transaction::Result Inventory::Add(const Transaction& transaction)
+{
+	const Transaction::Result result = CanAdd(transaction);
+	if (result != Transaction::Result::OK)
+		return result;
+
+	ItemCatalog& catalog = ItemCatalog::GetInstance();
+	const auto& lines = transaction.GetLines();
+
+	// The new entries are created before any line is applied, so a failure leaves the inventory as it was
+	std::vector<std::shared_ptr<Item>> new_items(lines.size());
+	std::vector<std::shared_ptr<Equipment>> new_equipment(lines.size());
+
+	for (size_t i = 0; i < lines.size(); i++)
+	{
+		const auto& line = lines[i];
+
+		if (line.pItem && !m_Items.IsValid(m_Items.Find(line.pItem->id)))
+		{
+			new_items[i] = catalog.CreateItem(*line.pItem, line.count);
+			if (!new_items[i])
+				return Transaction::Result::CAN_NOT_CREATE;
+		}
+		else if (line.pEquipment && !m_Equipment.IsValid(m_Equipment.Find(line.pEquipment->id)))
+		{
+			new_equipment[i] = catalog.CreateEquipment(*line.pEquipment, line.count);
+			if (!new_equipment[i])
+				return Transaction::Result::CAN_NOT_CREATE;
+		}
+	}
+
+	for (size_t i = 0; i < lines.size(); i++)
+	{
+		const auto& line = lines[i];
+		bool added = false;
+
+		if (new_items[i])
+			added = AddItem(std::move(new_items[i]));
+		else if (new_equipment[i])
+			added = AddEquipment(std::move(new_equipment[i]));
+		else if (line.pItem)
+		{
+			added = (*m_Items.Get(m_Items.Find(line.pItem->id)))->AddItem(line.count);
+			m_ItemVersion += added ? 1 : 0;
+		}
+		else
+		{
+			added = (*m_Equipment.Get(m_Equipment.Find(line.pEquipment->id)))->Add(line.count);
+			m_EquipmentVersion += added ? 1 : 0;
+		}
+
+		// CanAdd checked every line, so this is a bug rather than a full stack
+		if (!added)
+		{
+			TRPG_LOG_CAT(LogLevel::ERR, LogCategory::INVENTORY, "Failed to add a checked transaction line");
+			return Transaction::Result::STACK_FULL;
+		}
+	}
+
+	return Transaction::Result::OK;
+}
+
+Transaction::Result Inventory::Remove(const Transaction& transaction)
+{
+	const Transaction::Result result = CanRemove(transaction);
+	if (result != Transaction::Result::OK)
+		return result;
+
+	for (const auto& line : transaction.GetLines())
+	{
+		if (line.pItem)
+		{
+			const Handle handle = m_Items.Find(line.pItem->id);
+			const auto& item = *m_Items.Get(handle);
+
+			item->Decrement(line.count);
+			if (item->GetCount() <= 0)
+				RemoveItem(handle);
+			else
+				m_ItemVersion++;
+		}
+		else
+		{
+			const Handle handle = m_Equipment.Find(line.pEquipment->id);
+			const auto& equipment = *m_Equipment.Get(handle);
+
+			equipment->Decrement(line.count);
+			if (equipment->GetCount() <= 0)
+				RemoveEquipment(handle);
+			else
+				m_EquipmentVersion++;
+		}
+	}
+
+	return Transaction::Result::OK;
+}
+
+Transaction::Result Inventory::Transfer(const Transaction& transaction, Inventory& from, Inventory& to)
+{
+	if (&from == &to)
+		return Transaction::Result::SAME_INVENTORY;
+
+	Transaction::Result result = from.CanRemove(transaction);
+	if (result != Transaction::Result::OK)
+		return result;
+
+	result = to.CanAdd(transaction);
+	if (result != Transaction::Result::OK)
+		return result;
+
+	// Adding is the step that can still fail, the items only leave once they have arrived
+	result = to.Add(transaction);
+	if (result != Transaction::Result::OK)
+		return result;
+
+	from.Remove(transaction);
+	return Transaction::Result::OK;
+}
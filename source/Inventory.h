@@ -2,26 +2,86 @@
 
 #include "Item.h"
 #include "Equipment.h"
+#include "InventoryView.h"
+#include "InventoryIndex.h"
+#include "InventoryList.h"
+#include "Transaction.h"
 #include <vector>
 #include <memory>
+#include <array>
 
 class Player;
 
 class Inventory
 {
+public:
+    using ItemView = InventoryView<std::shared_ptr<Item>>;
+    using EquipmentView = InventoryView<std::shared_ptr<Equipment>>;
+    using EquipmentIndex = InventoryIndex<std::shared_ptr<Equipment>>;
+
 private:
-    std::vector<std::shared_ptr<Item>> m_Items;
-    std::vector<std::shared_ptr<Equipment>> m_Equipment;
+    // Keyed by definition id, so each item has one stacked entry
+    InventoryList<std::shared_ptr<Item>> m_Items;
+    InventoryList<std::shared_ptr<Equipment>> m_Equipment;
+
+    std::array<ItemView, static_cast<size_t>(InventorySort::NUM_SORTS)> m_ItemViews;
+    std::array<EquipmentView, static_cast<size_t>(InventorySort::NUM_SORTS)> m_EquipmentViews;
+
+    // By name, the unequipped entries that go in each slot and all the entries of each type
+    EquipmentIndex m_EquipmentBySlot;
+    EquipmentIndex m_EquipmentByType;
+
+    // Bumped on every change to the list, so a menu can tell whether what it shows is out of date
+    uint64_t m_ItemVersion;
+    uint64_t m_EquipmentVersion;
+
+    void CreateViews();
 
 public:
+    using Handle = InventoryHandle;
+
     Inventory(); // Declaration only
     ~Inventory() = default;
 
-    const std::vector<std::shared_ptr<Item>>& GetItems() const { return m_Items; }
-    const std::vector<std::shared_ptr<Equipment>>& GetEquipment() const { return m_Equipment; }
+    // Not in any particular order, removing an entry moves the last one into its place
+    const std::vector<std::shared_ptr<Item>>& GetItems() const { return m_Items.GetEntries(); }
+    const std::vector<std::shared_ptr<Equipment>>& GetEquipment() const { return m_Equipment.GetEntries(); }
+
+    // NULL_INVENTORY_HANDLE when the inventory has none of the definition
+    inline Handle FindItem(uint32_t definition_id) const { return m_Items.Find(definition_id); }
+    inline Handle FindEquipment(uint32_t definition_id) const { return m_Equipment.Find(definition_id); }
+    inline Handle GetItemHandle(size_t index) const { return m_Items.GetHandle(index); }
+    inline Handle GetEquipmentHandle(size_t index) const { return m_Equipment.GetHandle(index); }
+    inline size_t GetItemIndex(Handle handle) const { return m_Items.GetIndex(handle); }
+    inline size_t GetEquipmentIndex(Handle handle) const { return m_Equipment.GetIndex(handle); }
+
+    // nullptr once the entry was removed
+    std::shared_ptr<Item> GetItem(Handle handle) const;
+    std::shared_ptr<Equipment> GetEquipment(Handle handle) const;
+
+    const ItemView& GetItemView(InventorySort sort) const { return m_ItemViews[static_cast<size_t>(sort)]; }
+    const EquipmentView& GetEquipmentView(InventorySort sort) const { return m_EquipmentViews[static_cast<size_t>(sort)]; }
+
+    // Indices into GetEquipment(), these stay the same objects so a selector can stay bound to them
+    const std::vector<size_t>& GetEquipmentForSlot(Stats::EquipSlots slot) const { return m_EquipmentBySlot.GetGroup(static_cast<int>(slot)); }
+    const std::vector<size_t>& GetEquipmentOfType(Equipment::EquipType type) const { return m_EquipmentByType.GetGroup(static_cast<int>(type)); }
+
+    const uint64_t GetItemVersion() const { return m_ItemVersion; }
+    const uint64_t GetEquipmentVersion() const { return m_EquipmentVersion; }
 
     bool AddItem(std::shared_ptr<Item> newItem);
     bool AddEquipment(std::shared_ptr<Equipment> newEquipment);
+    bool RemoveItem(Handle handle);
+    bool RemoveEquipment(Handle handle);
+    // Equipping happens on the item itself, so whoever equips it reports it here
+    void OnEquippedChanged(uint32_t definition_id);
     bool UseItem(int index, Player& player);
-};
+    bool UseItem(Handle handle, Player& player);
 
+    // Every line is checked before anything changes, so the whole transaction goes through or none of it does
+    Transaction::Result CanAdd(const Transaction& transaction) const;
+    Transaction::Result CanRemove(const Transaction& transaction) const;
+    Transaction::Result Add(const Transaction& transaction);
+    Transaction::Result Remove(const Transaction& transaction);
+    static Transaction::Result Transfer(const Transaction& transaction, Inventory& from, Inventory& to);
+};
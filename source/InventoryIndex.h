@@ -0,0 +1,65 @@
+#pragma once
+
+#include "InventoryView.h"
+#include <vector>
+
+/*
+* Sorted lists of the entries in each group of one of the Inventory lists, such as the equipment for each slot.
+* Every list is kept up to date as entries are added, removed or change group, so a menu can bind
+* straight to the one it shows. Entries with a group outside [0, num_groups) are left out.
+*/
+template <typename T>
+class InventoryIndex
+{
+public:
+    using Compare = typename InventoryView<T>::Compare;
+    using GroupKey = std::function<int(const T&)>;
+
+private:
+    std::vector<InventoryView<T>> m_Groups;
+    GroupKey m_GroupKey;
+
+    // Returned for groups that are out of range
+    inline static const std::vector<size_t> EMPTY_GROUP{};
+
+public:
+    InventoryIndex(size_t num_groups = 0, Compare compare = nullptr, GroupKey group_key = nullptr)
+        : m_Groups(num_groups, InventoryView<T>{ compare }), m_GroupKey{ group_key }
+    {
+    }
+
+    ~InventoryIndex() = default;
+
+    // Indices into the list, in the order of compare
+    inline const std::vector<size_t>& GetGroup(int group) const
+    {
+        if (group < 0 || group >= static_cast<int>(m_Groups.size()))
+            return EMPTY_GROUP;
+
+        return m_Groups[group].GetOrder();
+    }
+
+    void OnAdd(const std::vector<T>& data, size_t index)
+    {
+        const int group = m_GroupKey(data[index]);
+        if (group >= 0 && group < static_cast<int>(m_Groups.size()))
+            m_Groups[group].OnAdd(data, index);
+    }
+
+    // The entry at index was removed and the entry at last moved into its place, either could be in any group.
+    // Groups that hold neither only check their position arrays
+    void OnRemove(size_t index, size_t last)
+    {
+        for (auto& group : m_Groups)
+            group.OnRemove(index, last);
+    }
+
+    // The group of the entry at index may have changed
+    void OnChanged(const std::vector<T>& data, size_t index)
+    {
+        for (auto& group : m_Groups)
+            group.Unlist(index);
+
+        OnAdd(data, index);
+    }
+};
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+// Refers to one entry of an InventoryList, stays valid while other entries are added and removed
+struct InventoryHandle
+{
+    uint32_t slot;
+    uint32_t generation;
+
+    bool operator==(const InventoryHandle& other) const = default;
+};
+
+inline constexpr InventoryHandle NULL_INVENTORY_HANDLE{ std::numeric_limits<uint32_t>::max(), 0 };
+
+/*
+* One entry per item definition, found by the definition id in O(1).
+* The entries are kept packed in a vector for iterating and for the Selectors to bind to.
+* Removing swaps the last entry into the gap instead of shifting everything after it,
+* handles go through a slot table so they follow the entry that moved and fail once theirs is removed.
+*/
+template <typename T>
+class InventoryList
+{
+private:
+    // Index of a free slot
+    static constexpr uint32_t NO_SLOT_INDEX = std::numeric_limits<uint32_t>::max();
+
+    struct Slot
+    {
+        uint32_t index;
+        uint32_t generation;
+        uint32_t definitionId;
+    };
+
+    std::vector<T> m_Entries;
+    // Slot of each entry, parallel to m_Entries
+    std::vector<uint32_t> m_EntrySlots;
+    std::vector<Slot> m_Slots;
+    std::vector<uint32_t> m_FreeSlots;
+    // Definition id -> slot
+    std::unordered_map<uint32_t, uint32_t> m_Index;
+
+public:
+    static constexpr size_t NO_INDEX = std::numeric_limits<size_t>::max();
+
+    InventoryList()
+        : m_Entries{}, m_EntrySlots{}, m_Slots{}, m_FreeSlots{}, m_Index{}
+    {
+    }
+
+    ~InventoryList() = default;
+
+    inline const std::vector<T>& GetEntries() const { return m_Entries; }
+    inline const size_t Size() const { return m_Entries.size(); }
+    inline const bool Empty() const { return m_Entries.empty(); }
+
+    inline const bool IsValid(InventoryHandle handle) const
+    {
+        return handle.slot < m_Slots.size() && m_Slots[handle.slot].generation == handle.generation
+            && m_Slots[handle.slot].index != NO_SLOT_INDEX;
+    }
+
+    // Index of the entry in GetEntries, NO_INDEX for a stale handle
+    inline const size_t GetIndex(InventoryHandle handle) const
+    {
+        return IsValid(handle) ? m_Slots[handle.slot].index : NO_INDEX;
+    }
+
+    inline const InventoryHandle GetHandle(size_t index) const
+    {
+        if (index >= m_Entries.size())
+            return NULL_INVENTORY_HANDLE;
+
+        const uint32_t slot = m_EntrySlots[index];
+        return { slot, m_Slots[slot].generation };
+    }
+
+    InventoryHandle Find(uint32_t definition_id) const
+    {
+        auto it = m_Index.find(definition_id);
+        if (it == m_Index.end())
+            return NULL_INVENTORY_HANDLE;
+
+        return { it->second, m_Slots[it->second].generation };
+    }
+
+    // nullptr for a stale handle
+    inline const T* Get(InventoryHandle handle) const
+    {
+        return IsValid(handle) ? &m_Entries[m_Slots[handle.slot].index] : nullptr;
+    }
+
+    // The definition must not already have an entry
+    InventoryHandle Add(uint32_t definition_id, T entry)
+    {
+        uint32_t slot;
+
+        if (!m_FreeSlots.empty())
+        {
+            slot = m_FreeSlots.back();
+            m_FreeSlots.pop_back();
+        }
+        else
+        {
+            slot = static_cast<uint32_t>(m_Slots.size());
+            m_Slots.push_back({ NO_SLOT_INDEX, 0, 0 });
+        }
+
+        m_Slots[slot].index = static_cast<uint32_t>(m_Entries.size());
+        m_Slots[slot].definitionId = definition_id;
+        m_Entries.push_back(std::move(entry));
+        m_EntrySlots.push_back(slot);
+        m_Index.emplace(definition_id, slot);
+
+        return { slot, m_Slots[slot].generation };
+    }
+
+    // Returns the index the entry had, the last entry now has that index
+    size_t Remove(InventoryHandle handle)
+    {
+        if (!IsValid(handle))
+            return NO_INDEX;
+
+        Slot& slot = m_Slots[handle.slot];
+        const size_t index = slot.index;
+        const size_t last = m_Entries.size() - 1;
+
+        if (index != last)
+        {
+            m_Entries[index] = std::move(m_Entries[last]);
+            m_EntrySlots[index] = m_EntrySlots[last];
+            m_Slots[m_EntrySlots[index]].index = static_cast<uint32_t>(index);
+        }
+
+        m_Entries.pop_back();
+        m_EntrySlots.pop_back();
+        m_Index.erase(slot.definitionId);
+
+        slot.index = NO_SLOT_INDEX;
+        slot.generation++;
+        m_FreeSlots.push_back(handle.slot);
+
+        return index;
+    }
+};
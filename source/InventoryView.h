@@ -0,0 +1,109 @@
+#pragma once
+
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <utility>
+
+enum class InventorySort { NAME = 0, PRICE, VALUE, SLOT, TYPE, NUM_SORTS };
+
+/*
+* Cached sort order over one of the Inventory lists.
+* Stores indices into the list and keeps them sorted as entries are added and removed,
+* instead of sorting again every time a menu asks for the list. The position of each index is kept too,
+* so removing an entry costs no more than erasing it from the order.
+* Views with a group key are ordered by that key first, so each group is one continuous range.
+*/
+template <typename T>
+class InventoryView
+{
+public:
+    using Compare = std::function<bool(const T&, const T&)>;
+    using GroupKey = std::function<int(const T&)>;
+
+private:
+    std::vector<size_t> m_Order;
+    // Where each index of the list is in m_Order, NOT_LISTED for entries the view leaves out
+    std::vector<size_t> m_Positions;
+    Compare m_Compare;
+    GroupKey m_GroupKey;
+
+    // Entries from position on moved in m_Order
+    void UpdatePositions(size_t position)
+    {
+        for (size_t i = position; i < m_Order.size(); i++)
+            m_Positions[m_Order[i]] = i;
+    }
+
+public:
+    static constexpr size_t NOT_LISTED = static_cast<size_t>(-1);
+
+    InventoryView(Compare compare = nullptr, GroupKey group_key = nullptr)
+        : m_Order{}, m_Positions{}, m_Compare{ compare }, m_GroupKey{ group_key }
+    {
+    }
+
+    ~InventoryView() = default;
+
+    inline const std::vector<size_t>& GetOrder() const { return m_Order; }
+    inline size_t GetPosition(size_t index) const { return index < m_Positions.size() ? m_Positions[index] : NOT_LISTED; }
+
+    void OnAdd(const std::vector<T>& data, size_t index)
+    {
+        // Entries that compare equal keep the order they were added in
+        auto it = std::upper_bound(m_Order.begin(), m_Order.end(), index,
+            [&](size_t lh, size_t rh) { return m_Compare(data[lh], data[rh]); });
+
+        const size_t position = static_cast<size_t>(it - m_Order.begin());
+        m_Order.insert(it, index);
+
+        if (m_Positions.size() <= index)
+            m_Positions.resize(index + 1, NOT_LISTED);
+        UpdatePositions(position);
+    }
+
+    // Takes index out of the order while the list itself stays the same
+    void Unlist(size_t index)
+    {
+        const size_t position = GetPosition(index);
+        if (position == NOT_LISTED)
+            return;
+
+        m_Order.erase(m_Order.begin() + position);
+        m_Positions[index] = NOT_LISTED;
+        UpdatePositions(position);
+    }
+
+    // The entry at index was removed and the entry at last moved into its place
+    void OnRemove(size_t index, size_t last)
+    {
+        Unlist(index);
+
+        // Same entry, so its place in the order does not change
+        const size_t moved = index != last ? GetPosition(last) : NOT_LISTED;
+        if (moved != NOT_LISTED)
+        {
+            m_Order[moved] = index;
+            m_Positions[index] = moved;
+        }
+
+        // The list is one shorter
+        if (m_Positions.size() > last)
+            m_Positions.resize(last);
+    }
+
+    // Returns the [first, last) range of m_Order whose entries belong to group
+    std::pair<size_t, size_t> GetGroup(const std::vector<T>& data, int group) const
+    {
+        if (!m_GroupKey)
+            return { 0, m_Order.size() };
+
+        auto first = std::lower_bound(m_Order.begin(), m_Order.end(), group,
+            [&](size_t index, int key) { return m_GroupKey(data[index]) < key; });
+
+        auto last = std::upper_bound(first, m_Order.end(), group,
+            [&](int key, size_t index) { return key < m_GroupKey(data[index]); });
+
+        return { static_cast<size_t>(first - m_Order.begin()), static_cast<size_t>(last - m_Order.begin()) };
+    }
+};
@@ -1,21 +1,31 @@
 #pragma once
 #include <string>
 #include "Equipment.h"
+#include "utility/StringTable.h"
 
 class Player;
 
 class Item 
 {
-public: enum ItemType { HEALTH = 0, STATUS_EFFECT, REVIVE, BATTLE, KEY_ITEM, NO_TYPE };
-private:
-    const int MAX_COUNT = 99;
-    ItemType m_eItemType;
+public: enum ItemType : uint8_t { HEALTH = 0, STATUS_EFFECT, REVIVE, BATTLE, KEY_ITEM, NO_TYPE };
+
+    // What every copy of an item shares, owned by the ItemCatalog
+    struct Definition
+    {
+        uint32_t id{ 0 };
+        InternedString name{ L"Item_Name" };
+        InternedString description{ L"Item description goes here!" };
+        ItemType type{ NO_TYPE };
+        int value{ 0 }, buyPrice{ 0 }, sellPrice{ 0 };
+    };
+
+    static constexpr int MAX_COUNT = 99;
+
 protected:
-    int m_Count{ 1 }, m_BuyPrice{ 0 }, m_SellPrice{ 0 }, m_ItemValue{ 0 };
-    std::wstring m_sItemName{ L"Item_Name" };
-    std::wstring m_sDescription{ L"Item description goes here!" };
+    const Definition* m_pDefinition;
+    int m_Count{ 1 };
 
-    void SetType(ItemType type) { m_eItemType = type; }
+    explicit Item(const Definition& definition) : m_pDefinition{ &definition } {}
 
 public:
     virtual ~Item() = default;
@@ -48,11 +58,13 @@ public:
         return true;
     }
 
-    inline const std::wstring& GetItemName() const { return m_sItemName; }
-    inline const std::wstring& GetDescription() const { return m_sDescription; }
-    inline const int GetBuyPrice() const { return m_BuyPrice; }
-    inline const int GetSellPrice() const { return m_SellPrice; }
+    inline const Definition& GetDefinition() const { return *m_pDefinition; }
+    inline const std::wstring& GetItemName() const { return m_pDefinition->name.Get(); }
+    inline const InternedString GetItemNameHandle() const { return m_pDefinition->name; }
+    inline const std::wstring& GetDescription() const { return m_pDefinition->description.Get(); }
+    inline const int GetBuyPrice() const { return m_pDefinition->buyPrice; }
+    inline const int GetSellPrice() const { return m_pDefinition->sellPrice; }
     inline const int GetMaxCount() const { return MAX_COUNT; }
-    inline const ItemType GetType() const { return m_eItemType;  }
-    inline const int GetItemValue() const { return m_ItemValue;  }
+    inline const ItemType GetType() const { return m_pDefinition->type;  }
+    inline const int GetItemValue() const { return m_pDefinition->value;  }
 };
@@ -1,36 +1,324 @@
 #define _CRT_SECURE_NO_WARNINGS
 
 #include "Logger.h"
+#include "utility/MPSCRing.h"
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cstdio>
 #include <ctime>
-#include <Windows.h>
-#include "utility/Colours.h"
-#include <iostream>
+#include <thread>
+#include <vector>
 
+namespace
+{
+    std::atomic<uint32_t> g_NumSites{ 0 };
+
+    // Fixed size so pushing a record never allocates, everything else about the message is in its site
+    struct LogRecord
+    {
+        const LogSite* site;
+        int64_t time_ms;
+        uint32_t length;
+        char payload[LOG_MAX_PAYLOAD];
+    };
+
+    /*
+    * Producers copy the message into the ring and return, the writer thread formats and writes them in batches.
+    * When the ring is full the message is dropped and counted, logging never waits on the file.
+    */
+    class AsyncLogger
+    {
+    private:
+        const size_t RING_CAPACITY = 4096;
+        const size_t BATCH_SIZE = 64 * 1024;
+#ifdef TRPG_BINARY_LOG
+        const char* LOG_FILE = "./trpg.bin";
+#else
+        const char* LOG_FILE = "./trpg.log";
+#endif
+
+        MPSCRing<LogRecord> m_Ring;
+        std::atomic<uint64_t> m_NumPushed, m_NumWritten, m_NumDropped;
+        std::atomic<bool> m_bRunning;
+
+        FILE* m_pFile;
+        std::string m_sBatch;
+        // Sites whose descriptor is already in the binary log
+        std::vector<bool> m_SitesWritten;
+
+        // The timestamp is only formatted again when the second changes
+        int64_t m_CachedSecond;
+        char m_CachedTime[32];
+
+        std::thread m_Thread;
+
+        const char* FormatTime(int64_t time_ms)
+        {
+            const int64_t second = time_ms / 1000;
+
+            if (second != m_CachedSecond)
+            {
+                const std::time_t time = static_cast<std::time_t>(second);
+                std::strftime(m_CachedTime, sizeof(m_CachedTime), "%y-%m-%d %H:%M:%S", std::localtime(&time));
+                m_CachedSecond = second;
+            }
+
+            return m_CachedTime;
+        }
+
+        void Format(const LogRecord& record)
+        {
+            const LogSite& site = *record.site;
+
+            char prefix[64];
+            const int prefix_length = site.category == LogCategory::GENERAL
+                ? std::snprintf(prefix, sizeof(prefix), "%s: %s.%03d - ",
+                    LOG_LEVEL_NAMES[static_cast<int>(site.level)], FormatTime(record.time_ms), static_cast<int>(record.time_ms % 1000))
+                : std::snprintf(prefix, sizeof(prefix), "%s: %s.%03d - [%s] ",
+                    LOG_LEVEL_NAMES[static_cast<int>(site.level)], FormatTime(record.time_ms), static_cast<int>(record.time_ms % 1000),
+                    LOG_CATEGORY_NAMES[static_cast<int>(site.category)]);
+
+            m_sBatch.append(prefix, std::max(prefix_length, 0));
+            FormatLogMessage(m_sBatch, site.format, record.payload, record.length);
+            m_sBatch += '\n';
+
+            if (site.level == LogLevel::ERR && site.line > 0)
+            {
+                char location[64];
+                const int location_length = std::snprintf(location, sizeof(location), "\nLINE: %u\n", site.line);
+
+                m_sBatch += "FILE: ";
+                m_sBatch += site.file;
+                m_sBatch += "\nFUNC: ";
+                m_sBatch += site.function;
+                m_sBatch.append(location, std::max(location_length, 0));
+            }
+        }
+
+        template <typename T>
+        void AppendBinary(const T& value)
+        {
+            m_sBatch.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        void AppendBinaryString(std::string_view text)
+        {
+            AppendBinary(static_cast<uint16_t>(text.size()));
+            m_sBatch.append(text.data(), text.size());
+        }
+
+        // The site is written once, before its first message, so the file can be decoded on its own
+        void WriteBinary(const LogRecord& record)
+        {
+            const LogSite& site = *record.site;
+
+            if (site.id >= m_SitesWritten.size())
+                m_SitesWritten.resize(site.id + 1, false);
+
+            if (!m_SitesWritten[site.id])
+            {
+                m_SitesWritten[site.id] = true;
+
+                m_sBatch += static_cast<char>(LogEntry::SITE);
+                AppendBinary(site.id);
+                AppendBinary(static_cast<uint8_t>(site.level));
+                AppendBinary(static_cast<uint8_t>(site.category));
+                AppendBinary(site.line);
+                AppendBinaryString(site.format);
+                AppendBinaryString(site.file);
+                AppendBinaryString(site.function);
+            }
+
+            m_sBatch += static_cast<char>(LogEntry::MESSAGE);
+            AppendBinary(site.id);
+            AppendBinary(record.time_ms);
+            AppendBinary(static_cast<uint16_t>(record.length));
+            m_sBatch.append(record.payload, record.length);
+        }
+
+        void WriteDropped(uint64_t dropped)
+        {
+#ifdef TRPG_BINARY_LOG
+            m_sBatch += static_cast<char>(LogEntry::DROPPED);
+            AppendBinary(dropped);
+#else
+            m_sBatch += "LOG: " + std::to_string(dropped) + " messages were dropped, the log queue was full\n";
+#endif
+        }
+
+        void Process(const LogRecord& record)
+        {
+#ifdef TRPG_BINARY_LOG
+            WriteBinary(record);
+#else
+            Format(record);
+#endif
+        }
+
+        void WriteBatch()
+        {
+            if (m_sBatch.empty())
+                return;
+
+            if (m_pFile)
+            {
+                std::fwrite(m_sBatch.data(), 1, m_sBatch.size(), m_pFile);
+                std::fflush(m_pFile);
+            }
+
+            m_sBatch.clear();
+        }
+
+        void Run()
+        {
+            while (true)
+            {
+                const bool running = m_bRunning.load(std::memory_order_acquire);
+                uint64_t num_popped = 0;
+
+                while (m_sBatch.size() < BATCH_SIZE && m_Ring.TryPop([&](const LogRecord& record) { Process(record); }))
+                    num_popped++;
+
+                if (const uint64_t dropped = m_NumDropped.exchange(0, std::memory_order_relaxed))
+                    WriteDropped(dropped);
+
+                WriteBatch();
+                m_NumWritten.fetch_add(num_popped, std::memory_order_release);
 
-std::string Logger::CurrentDate()
+                // Everything pushed before stopping has been written
+                if (!running && num_popped == 0)
+                    return;
+
+                if (num_popped == 0)
+                    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+        }
+
+    public:
+        AsyncLogger()
+            : m_Ring{ RING_CAPACITY }, m_NumPushed{ 0 }, m_NumWritten{ 0 }, m_NumDropped{ 0 }, m_bRunning{ true }
+            , m_pFile{ std::fopen(LOG_FILE, "wb") }, m_sBatch{}, m_SitesWritten{}, m_CachedSecond{ -1 }, m_CachedTime{}, m_Thread{}
+        {
+            m_sBatch.reserve(BATCH_SIZE + 1024);
+#ifdef TRPG_BINARY_LOG
+            m_sBatch.append(LOG_BINARY_MAGIC, sizeof(LOG_BINARY_MAGIC));
+#endif
+            m_Thread = std::thread{ &AsyncLogger::Run, this };
+        }
+
+        ~AsyncLogger()
+        {
+            m_bRunning.store(false, std::memory_order_release);
+
+            if (m_Thread.joinable())
+                m_Thread.join();
+
+            if (m_pFile)
+                std::fclose(m_pFile);
+        }
+
+        void Push(const LogSite& site, const char* payload, size_t length)
+        {
+            const int64_t time_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+
+            const bool pushed = m_Ring.TryPush([&](LogRecord& record) {
+                record.site = &site;
+                record.time_ms = time_ms;
+                record.length = static_cast<uint32_t>(std::min(length, LOG_MAX_PAYLOAD));
+                std::copy_n(payload, record.length, record.payload);
+                });
+
+            if (pushed)
+                m_NumPushed.fetch_add(1, std::memory_order_relaxed);
+            else
+                m_NumDropped.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void Flush()
+        {
+            const uint64_t target = m_NumPushed.load(std::memory_order_relaxed);
+            const auto give_up = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+
+            while (m_NumWritten.load(std::memory_order_acquire) < target && std::chrono::steady_clock::now() < give_up)
+                std::this_thread::yield();
+        }
+    };
+
+    AsyncLogger& GetAsyncLogger()
+    {
+        static AsyncLogger logger;
+        return logger;
+    }
+}
+
+std::atomic<int> Logger::s_Level{ static_cast<int>(TRPG_COMPILE_LOG_LEVEL) };
+std::atomic<uint32_t> Logger::s_CategoryMask{ ~0u };
+
+LogSite::LogSite(LogLevel level, LogCategory category, const char* format, std::source_location location)
+    : level{ level }, category{ category }, format{ format }
+    , file{ location.file_name() }, function{ location.function_name() }, line{ location.line() }
+    , id{ g_NumSites.fetch_add(1, std::memory_order_relaxed) }
+{
+}
+
+bool LogRateLimiter::Allow(const LogSite& site)
 {
-    std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    const int64_t now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
 
-    std::string output( 30, '\0' );
-    std::strftime(&output[0], output.size(), "%y-%m-%d %H:%M:%S", std::localtime(&now));
+    // The first message of a new second resets the window and reports what the last one held back
+    int64_t window_start = m_WindowStart.load(std::memory_order_relaxed);
+    if (now_ms - window_start >= 1000 && m_WindowStart.compare_exchange_strong(window_start, now_ms, std::memory_order_relaxed))
+    {
+        m_NumInWindow.store(0, std::memory_order_relaxed);
 
-    return output;
+        static const LogSite suppressed_site{ LogLevel::WARN, LogCategory::GENERAL, "{} messages from {}:{} were suppressed" };
+        if (const uint32_t suppressed = m_NumSuppressed.exchange(0, std::memory_order_relaxed))
+            Logger::Write(suppressed_site, suppressed, site.file, site.line);
+    }
 
+    if (m_NumInWindow.fetch_add(1, std::memory_order_relaxed) < MAX_PER_SECOND)
+        return true;
+
+    m_NumSuppressed.fetch_add(1, std::memory_order_relaxed);
+    return false;
 }
 
 void Logger::Log(const std::string_view message)
 {
-    HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
-    SetConsoleTextAttribute(hConsole, GREEN);
-    std::cout << "LOG: " << CurrentDate() << " - " << message << "\n";
-    SetConsoleTextAttribute(hConsole, WHITE);
+    static const LogSite site{ LogLevel::INFO, LogCategory::GENERAL, "{}" };
+
+    if (IsEnabled(site.level, site.category))
+        Write(site, message);
 }
 
 void Logger::Error(const std::string_view message, std::source_location location)
 {
-    HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
-    SetConsoleTextAttribute(hConsole, RED);
-    std::cout << "ERROR: " << CurrentDate() << " - " << message << "\nFILE: " << location.file_name() << "\nFUNC: " << location.function_name() << "\nLINE: " << location.line() << "\n";
-    SetConsoleTextAttribute(hConsole, WHITE);
+    // The site has no location of its own, the caller's location is written as part of the message
+    static const LogSite site{ LogLevel::ERR, LogCategory::GENERAL, "{}\nFILE: {}\nFUNC: {}\nLINE: {}", std::source_location{} };
+
+    if (IsEnabled(site.level, site.category))
+        Write(site, message, location.file_name(), location.function_name(), location.line());
+}
+
+void Logger::Push(const LogSite& site, const char* payload, size_t length)
+{
+    GetAsyncLogger().Push(site, payload, length);
+}
+
+void Logger::SetCategoryEnabled(LogCategory category, bool enabled)
+{
+    const uint32_t bit = 1u << static_cast<uint32_t>(category);
+
+    if (enabled)
+        s_CategoryMask.fetch_or(bit, std::memory_order_relaxed);
+    else
+        s_CategoryMask.fetch_and(~bit, std::memory_order_relaxed);
+}
+
+void Logger::Flush()
+{
+    GetAsyncLogger().Flush();
 }
@@ -3,21 +3,125 @@
 #include <string_view>
 #include <source_location>
 #include <string>
+#include <atomic>
+#include <cstdint>
 #include "utility/Colours.h"
+#include "utility/LogFormat.h"
 
-#define TRPG_LOG(x) Logger::Log(x);
-#define TRPG_ERROR(x) Logger::Error(x);
+enum class LogLevel { TRACE = 0, INFO, WARN, ERR, NONE };
+enum class LogCategory { GENERAL = 0, INPUT, STATE, INVENTORY, LOADER, UI, NUM_CATEGORIES };
 
+// Messages below this level are compiled out, define TRPG_LOG_LEVEL to the number of a LogLevel to change it
+#ifndef TRPG_LOG_LEVEL
+#ifdef _DEBUG
+#define TRPG_LOG_LEVEL 0
+#else
+#define TRPG_LOG_LEVEL 1
+#endif
+#endif
+
+constexpr LogLevel TRPG_COMPILE_LOG_LEVEL = static_cast<LogLevel>(TRPG_LOG_LEVEL);
+
+/*
+* The arguments are only evaluated when the level and category are enabled, and every call site
+* is rate limited so a message logged in a loop cannot flood the log.
+* Each {} in format is replaced by the next argument when the log is written, not when it is called.
+*/
+#define TRPG_LOGF(level, category, format, ...) \
+    do { \
+        if constexpr (level >= TRPG_COMPILE_LOG_LEVEL) \
+        { \
+            if (Logger::IsEnabled(level, category)) \
+            { \
+                static const LogSite trpg_log_site{ level, category, format }; \
+                static LogRateLimiter trpg_log_limiter; \
+                if (trpg_log_limiter.Allow(trpg_log_site)) \
+                    Logger::Write(trpg_log_site, ##__VA_ARGS__); \
+            } \
+        } \
+    } while (false)
+
+#define TRPG_LOG_CAT(level, category, x) TRPG_LOGF(level, category, "{}", x)
+
+#define TRPG_TRACE(x) TRPG_LOG_CAT(LogLevel::TRACE, LogCategory::GENERAL, x)
+#define TRPG_LOG(x) TRPG_LOG_CAT(LogLevel::INFO, LogCategory::GENERAL, x)
+#define TRPG_WARN(x) TRPG_LOG_CAT(LogLevel::WARN, LogCategory::GENERAL, x)
+#define TRPG_ERROR(x) TRPG_LOG_CAT(LogLevel::ERR, LogCategory::GENERAL, x)
+
+/*
+* Everything about a call site that is known when it is compiled. A site is registered the first time
+* it logs, after that its messages only carry its id, a timestamp and the raw bytes of their arguments.
+*/
+struct LogSite
+{
+    LogLevel level;
+    LogCategory category;
+    const char* format;
+    const char* file;
+    const char* function;
+    uint32_t line;
+    uint32_t id;
+
+    LogSite(LogLevel level, LogCategory category, const char* format, std::source_location location = std::source_location::current());
+};
+
+/*
+* Allows up to MAX_PER_SECOND messages a second from one call site.
+* The number of messages held back is logged once the next message gets through.
+*/
+class LogRateLimiter
+{
+private:
+    static const uint32_t MAX_PER_SECOND = 10;
+
+    std::atomic<int64_t> m_WindowStart;
+    std::atomic<uint32_t> m_NumInWindow, m_NumSuppressed;
+
+public:
+    LogRateLimiter() : m_WindowStart{ 0 }, m_NumInWindow{ 0 }, m_NumSuppressed{ 0 } {}
+
+    bool Allow(const LogSite& site);
+};
+
+/*
+* Messages are queued and written to trpg.log by a background thread, so logging does not wait on the file.
+* When built with TRPG_BINARY_LOG they are written unformatted to trpg.bin instead, read it with tools/LogDecoder.
+*/
 class Logger
 {
 private:
-	static std::string CurrentDate();
+	static std::atomic<int> s_Level;
+	static std::atomic<uint32_t> s_CategoryMask;
+
 public:
 	Logger() {};
 	~Logger() = default;
 
 	static void Log(const std::string_view message);
 	static void Error(const std::string_view message, std::source_location location = std::source_location::current());
+	static void Push(const LogSite& site, const char* payload, size_t length);
 
-};
+	template <typename... Args>
+	static void Write(const LogSite& site, const Args&... args)
+	{
+		char payload[LOG_MAX_PAYLOAD];
+		LogArgWriter writer{ payload, LOG_MAX_PAYLOAD };
+		(writer.Add(args), ...);
+
+		Push(site, payload, writer.GetLength());
+	}
+
+	// Waits until everything logged so far is written
+	static void Flush();
 
+	// Runtime filters, they can only hide messages that were compiled in
+	static void SetLevel(LogLevel level) { s_Level.store(static_cast<int>(level), std::memory_order_relaxed); }
+	static LogLevel GetLevel() { return static_cast<LogLevel>(s_Level.load(std::memory_order_relaxed)); }
+	static void SetCategoryEnabled(LogCategory category, bool enabled);
+
+	static bool IsEnabled(LogLevel level, LogCategory category)
+	{
+		return static_cast<int>(level) >= s_Level.load(std::memory_order_relaxed) &&
+			(s_CategoryMask.load(std::memory_order_relaxed) & (1u << static_cast<uint32_t>(category))) != 0;
+	}
+};
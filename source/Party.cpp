@@ -2,6 +2,7 @@
 #include "Player.h"
 #include "Logger.h"
 #include "utility/trpg_utilities.h"
+#include <algorithm>
 
 Party::Party()
     : m_PartyMembers{}
@@ -19,13 +20,13 @@ bool Party::AddMember(std::shared_ptr<Player> newMember)
 {
     if (m_PartyMembers.size() >= MAX_MEMBERS)
     {
-        TRPG_ERROR("There are already [" + std::to_string(MAX_MEMBERS) + "] members in the party!\nPlease remove!");
+        TRPG_LOGF(LogLevel::ERR, LogCategory::GENERAL, "There are already [{}] members in the party!\nPlease remove!", MAX_MEMBERS);
         return false;
     }
 
     for (const auto& member : m_PartyMembers)
     {
-        if (member->GetID() == newMember->GetID())
+        if (member->GetIDHandle() == newMember->GetIDHandle())
         {
             TRPG_ERROR("Member is already in the Party!");
             return false;
@@ -44,48 +45,56 @@ bool Party::AddMember(std::shared_ptr<Player> newMember)
     return true;
 }
 
-bool Party::BuyEquipment(int price, std::shared_ptr<Equipment> equipment)
+void Party::AddGold(int gold)
 {
-    // Check if the party has enough gold
+    m_Gold = std::clamp(m_Gold + gold, 0, MAX_GOLD);
+}
+
+Transaction::Result Party::Buy(const Transaction& transaction)
+{
+    if (transaction.Empty())
+        return Transaction::Result::EMPTY;
+
+    const int price = transaction.GetBuyPrice();
     if (m_Gold < price)
-    {
-        return false; // Not enough gold
-    }
+        return Transaction::Result::NOT_ENOUGH_GOLD;
+
+    const Transaction::Result result = m_Inventory.Add(transaction);
+    if (result != Transaction::Result::OK)
+        return result;
 
-    // Deduct the gold
     m_Gold -= price;
+    return Transaction::Result::OK;
+}
 
-    // Add the equipment to the inventory
-    if (!m_Inventory.AddEquipment(equipment))
-    {
-        // If adding the equipment fails, refund the gold
-        m_Gold += price;
-        return false;
-    }
+Transaction::Result Party::Sell(const Transaction& transaction)
+{
+    if (transaction.Empty())
+        return Transaction::Result::EMPTY;
+
+    const int price = transaction.GetSellPrice();
+    if (m_Gold + price > MAX_GOLD)
+        return Transaction::Result::TOO_MUCH_GOLD;
+
+    const Transaction::Result result = m_Inventory.Remove(transaction);
+    if (result != Transaction::Result::OK)
+        return result;
 
-    return true; // Purchase successful
+    m_Gold += price;
+    return Transaction::Result::OK;
 }
-#include "Party.h"
-#include "Item.h"
 
-bool Party::BuyItem(int price, std::shared_ptr<Item> item)
+Transaction::Result Party::Transfer(const Transaction& transaction, Party& to)
 {
-    // Check if the party has enough gold
-    if (m_Gold < price)
-    {
-        return false; // Not enough gold
-    }
-
-    // Deduct the gold
-    m_Gold -= price;
+    return Inventory::Transfer(transaction, m_Inventory, to.m_Inventory);
+}
 
-    // Add the item to the inventory
-    if (!m_Inventory.AddItem(item))
-    {
-        // If adding the item fails, refund the gold
-        m_Gold += price;
-        return false;
-    }
+Transaction::Result Party::Store(const Transaction& transaction, Inventory& storage)
+{
+    return Inventory::Transfer(transaction, m_Inventory, storage);
+}
 
-    return true; // Purchase successful
+Transaction::Result Party::Retrieve(const Transaction& transaction, Inventory& storage)
+{
+    return Inventory::Transfer(transaction, storage, m_Inventory);
 }
@@ -31,6 +31,11 @@ public:
     void AddGold(int gold);
     const int GetNumActiveMembers() const { return m_NumActiveMembers; }
 
-    bool BuyItem(int price, std::shared_ptr<Item> item);
-    bool BuyEquipment(int price, std::shared_ptr<Equipment> equipment);
+    // Gold and the inventory change together or not at all
+    Transaction::Result Buy(const Transaction& transaction);
+    Transaction::Result Sell(const Transaction& transaction);
+    Transaction::Result Transfer(const Transaction& transaction, Party& to);
+    // Storage is any inventory kept outside the party
+    Transaction::Result Store(const Transaction& transaction, Inventory& storage);
+    Transaction::Result Retrieve(const Transaction& transaction, Inventory& storage);
 };
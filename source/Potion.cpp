@@ -1,14 +1,9 @@
 #include "Potion.h"
 #include "Player.h"
 
-Potion::Potion(const std::wstring& item_name, const std::wstring& desc, int health, int buy_price)
+Potion::Potion(const Definition& definition)
+    : Item(definition)
 {
-    m_sItemName = item_name;
-    m_sDescription = desc;
-    m_ItemValue = health;
-    m_BuyPrice = buy_price;
-    m_SellPrice = buy_price / 2;
-    SetType(ItemType::HEALTH);
 }
 
 Potion::~Potion()
@@ -0,0 +1,127 @@
+#include "Profiler.h"
+
+#ifdef TRPG_ENABLE_PROFILER
+
+#include "Logger.h"
+#include <Windows.h>
+#include <fstream>
+
+namespace
+{
+    thread_local ProfileBuffer* t_pBuffer = nullptr;
+
+    void WriteJsonString(std::ofstream& file, const char* str)
+    {
+        file << '"';
+        for (const char* c = str; *c; c++)
+        {
+            if (*c == '"' || *c == '\\')
+                file << '\\';
+
+            file << *c;
+        }
+        file << '"';
+    }
+}
+
+Profiler::Profiler()
+    : m_StartPoint{ std::chrono::steady_clock::now() }, m_BuffersMutex{}, m_Buffers{}
+{
+}
+
+Profiler& Profiler::GetInstance()
+{
+    // Any thread may be the first to open a scope
+    static Profiler instance;
+    return instance;
+}
+
+ProfileBuffer& Profiler::GetThreadBuffer()
+{
+    if (t_pBuffer)
+        return *t_pBuffer;
+
+    auto buffer = std::make_unique<ProfileBuffer>();
+    buffer->thread_id = static_cast<uint32_t>(GetCurrentThreadId());
+    buffer->events.reserve(4096);
+
+    std::lock_guard<std::mutex> lock{ m_BuffersMutex };
+    t_pBuffer = buffer.get();
+    m_Buffers.push_back(std::move(buffer));
+
+    return *t_pBuffer;
+}
+
+void Profiler::Record(ProfileBuffer& buffer, const char* name, int64_t start_us, int64_t end_us)
+{
+    // Stop recording instead of growing without limit when the profiler is left running
+    if (buffer.events.size() >= MAX_EVENTS_PER_THREAD)
+    {
+        buffer.dropped++;
+        return;
+    }
+
+    buffer.events.push_back(ProfileEvent{ name, start_us, end_us - start_us, buffer.depth });
+}
+
+bool Profiler::WriteChromeTrace(const std::string& filepath)
+{
+    std::ofstream file{ filepath };
+
+    if (!file.is_open())
+    {
+        TRPG_ERROR("Failed to open [" + filepath + "] for the profiler trace");
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock{ m_BuffersMutex };
+
+    const DWORD process_id = GetCurrentProcessId();
+    size_t num_events = 0, num_dropped = 0;
+    bool first = true;
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    for (const auto& buffer : m_Buffers)
+    {
+        for (const auto& event : buffer->events)
+        {
+            if (!first)
+                file << ",\n";
+
+            first = false;
+
+            // Complete events, the viewer nests them by their start and duration
+            file << "{\"name\":";
+            WriteJsonString(file, event.name);
+            file << ",\"cat\":\"trpg\",\"ph\":\"X\",\"ts\":" << event.start_us << ",\"dur\":" << event.duration_us
+                << ",\"pid\":" << process_id << ",\"tid\":" << buffer->thread_id
+                << ",\"args\":{\"depth\":" << event.depth << "}}";
+        }
+
+        num_events += buffer->events.size();
+        num_dropped += buffer->dropped;
+    }
+
+    file << "\n]}\n";
+
+    TRPG_LOGF(LogLevel::INFO, LogCategory::GENERAL, "Wrote {} profiler events to [{}], dropped {}", num_events, filepath, num_dropped);
+    return true;
+}
+
+ProfileScope::ProfileScope(const char* name)
+    : m_Buffer{ Profiler::GetInstance().GetThreadBuffer() }, m_sName{ name }, m_StartUS{ 0 }
+{
+    m_Buffer.depth++;
+    m_StartUS = Profiler::GetInstance().NowUS();
+}
+
+ProfileScope::~ProfileScope()
+{
+    const int64_t end_us = Profiler::GetInstance().NowUS();
+
+    m_Buffer.depth--;
+    Profiler::GetInstance().Record(m_Buffer, m_sName, m_StartUS, end_us);
+}
+
+#endif
@@ -0,0 +1,85 @@
+#pragma once
+
+#ifdef TRPG_ENABLE_PROFILER
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#define TRPG_PROFILE_JOIN_INNER(a, b) a##b
+#define TRPG_PROFILE_JOIN(a, b) TRPG_PROFILE_JOIN_INNER(a, b)
+
+// name must be a string literal, or outlive the profiler
+#define TRPG_PROFILE_SCOPE(name) ProfileScope TRPG_PROFILE_JOIN(profile_scope_, __LINE__){ name }
+#define TRPG_PROFILE_FUNCTION() TRPG_PROFILE_SCOPE(__FUNCTION__)
+#define TRPG_PROFILE_DUMP(filepath) Profiler::GetInstance().WriteChromeTrace(filepath)
+
+struct ProfileEvent
+{
+    const char* name;
+    int64_t start_us, duration_us;
+    uint32_t depth;
+};
+
+/*
+* Events recorded by one thread. Only the owning thread writes to it, so recording takes no lock.
+*/
+struct ProfileBuffer
+{
+    std::vector<ProfileEvent> events;
+    uint32_t thread_id{ 0 }, depth{ 0 };
+    size_t dropped{ 0 };
+};
+
+class Profiler
+{
+private:
+    const size_t MAX_EVENTS_PER_THREAD = 1 << 20;
+
+    std::chrono::time_point<std::chrono::steady_clock> m_StartPoint;
+    // Locked when a thread first records and when writing the trace
+    std::mutex m_BuffersMutex;
+    std::vector<std::unique_ptr<ProfileBuffer>> m_Buffers;
+
+    Profiler();
+
+public:
+    static Profiler& GetInstance();
+
+    ProfileBuffer& GetThreadBuffer();
+    inline const int64_t NowUS() const
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_StartPoint).count();
+    }
+
+    void Record(ProfileBuffer& buffer, const char* name, int64_t start_us, int64_t end_us);
+
+    // Writes every recorded event as Chrome trace JSON, for chrome://tracing or Perfetto
+    bool WriteChromeTrace(const std::string& filepath);
+};
+
+class ProfileScope
+{
+private:
+    ProfileBuffer& m_Buffer;
+    const char* m_sName;
+    int64_t m_StartUS;
+
+public:
+    ProfileScope(const char* name);
+    ~ProfileScope();
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+#else
+
+#define TRPG_PROFILE_SCOPE(name)
+#define TRPG_PROFILE_FUNCTION()
+#define TRPG_PROFILE_DUMP(filepath)
+
+#endif
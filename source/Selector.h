@@ -8,6 +8,7 @@
 #include "Console.h"
 #include "Inputs/Keyboard.h"
 #include "Logger.h"
+#include "utility/SearchIndex.h"
 
 struct SelectorParams
 {
@@ -38,16 +39,31 @@ private:
     std::function<void(int, std::vector<T>)> m_OnSelection;
     std::function<void(int, int, T)> m_OnDrawItem;
     std::vector<T> m_Data;
+    const std::vector<T>* m_pBoundData;
+    const std::vector<size_t>* m_pBoundOrder;
     SelectorParams m_Params;
     bool m_bShowCursor;
     int m_Rows;
 
+    std::function<const std::wstring& (const T&)> m_GetSearchName;
+    SearchIndex m_SearchIndex;
+    bool m_bSearching, m_bSearchIndexDirty;
+    int m_SearchX, m_SearchY;
+
     void MoveUp();
     void MoveDown();
     void MoveLeft();
     void MoveRight();
     void OnAction();
 
+    inline const std::vector<T>& Data() const { return m_pBoundData ? *m_pBoundData : m_Data; }
+    void UpdateRows();
+    int GetNumVisible() const;
+    int GetDataIndex(int visibleIndex) const;
+    void ProcessSearchInputs();
+    void BuildSearchIndex();
+    void OnSearchChanged();
+
     void DrawItem(int x, int y, T item);
     void OnSelection(int index, std::vector<T> data);
 
@@ -58,14 +74,24 @@ public:
         std::function<void(int, int, T)> on_draw_item, std::vector<T> data, SelectorParams params = SelectorParams());
     ~Selector();
 
-    void SetData(std::vector<T> data) { m_Data = data; }
-    std::vector<T>& GetData() { return m_Data; }
+    void SetData(std::vector<T> data);
+    const std::vector<T>& GetData() const { return Data(); }
+
+    // Shows data in the given order without copying it. Both must outlive the binding,
+    // call Refresh() after they change
+    void BindData(const std::vector<T>& data, const std::vector<size_t>& order);
+    void Refresh();
 
     void SetSelectionFunc(std::function<void(int, std::vector<T>)> on_selection) { m_OnSelection = on_selection; }
     void SetDrawFunc(std::function<void(int, int, T)> on_draw_item) { m_OnDrawItem = on_draw_item; }
     void ShowCursor() { m_bShowCursor = true; }
     void HideCursor() { m_bShowCursor = false; }
-    const int GetIndex() const { return m_Params.currentX + (m_Params.currentY * m_Params.columns); }
+    const int GetIndex() const { return GetDataIndex(m_Params.currentX + (m_Params.currentY * m_Params.columns)); }
+
+    // Type-to-filter over the names returned by get_name, toggled with F3
+    void EnableSearch(std::function<const std::wstring& (const T&)> get_name, int x, int y);
+    void StopSearch();
+    inline const bool IsSearching() const { return m_bSearching; }
 
     void ProcessInputs();
     void Draw();
@@ -91,23 +117,228 @@ inline Selector<T>::Selector(Console& console, Keyboard& keyboard,
     , m_OnSelection(on_selection)
     , m_OnDrawItem(on_draw_item)
     , m_Data(data)
+    , m_pBoundData(nullptr)
+    , m_pBoundOrder(nullptr)
     , m_Params(params)
     , m_bShowCursor(true)
+    , m_GetSearchName(nullptr)
+    , m_SearchIndex()
+    , m_bSearching(false), m_bSearchIndexDirty(true)
+    , m_SearchX(0), m_SearchY(0)
+{
+    UpdateRows();
+}
+
+template<typename T>
+inline Selector<T>::~Selector()
+{
+}
+
+template<typename T>
+inline void Selector<T>::SetData(std::vector<T> data)
+{
+    m_Data = data;
+    m_pBoundData = nullptr;
+    m_pBoundOrder = nullptr;
+    Refresh();
+}
+
+template<typename T>
+inline void Selector<T>::BindData(const std::vector<T>& data, const std::vector<size_t>& order)
+{
+    m_Data.clear();
+    m_pBoundData = &data;
+    m_pBoundOrder = &order;
+    Refresh();
+}
+
+template<typename T>
+inline void Selector<T>::Refresh()
 {
-    m_Rows = std::ceil(static_cast<float>(m_Data.size()) / (params.columns == 0 ? 1 : params.columns));
+    m_bSearchIndexDirty = true;
+
+    // The index is only rebuilt when a search actually needs it
+    if (m_bSearching)
+    {
+        const std::wstring query = m_SearchIndex.GetQuery();
+        BuildSearchIndex();
+
+        for (const auto& character : query)
+            m_SearchIndex.Push(character);
+    }
+
+    UpdateRows();
+    m_Params.currentY = std::min(m_Params.currentY, m_Rows - 1);
+}
+
+template<typename T>
+inline void Selector<T>::EnableSearch(std::function<const std::wstring& (const T&)> get_name, int x, int y)
+{
+    m_GetSearchName = get_name;
+    m_SearchX = x;
+    m_SearchY = y;
+    m_bSearchIndexDirty = true;
+}
+
+template<typename T>
+inline void Selector<T>::StopSearch()
+{
+    if (!m_bSearching)
+        return;
+
+    m_bSearching = false;
+    m_SearchIndex.ClearQuery();
+    OnSearchChanged();
+}
+
+template<typename T>
+inline void Selector<T>::UpdateRows()
+{
+    m_Rows = std::ceil(static_cast<float>(GetNumVisible()) / (m_Params.columns == 0 ? 1 : m_Params.columns));
 
     if (m_Rows < 1)
         m_Rows = 1;
 }
 
 template<typename T>
-inline Selector<T>::~Selector()
+inline int Selector<T>::GetNumVisible() const
+{
+    if (m_bSearching)
+        return static_cast<int>(m_SearchIndex.GetMatches().size());
+
+    if (m_pBoundOrder)
+        return static_cast<int>(m_pBoundOrder->size());
+
+    return static_cast<int>(Data().size());
+}
+
+template<typename T>
+inline int Selector<T>::GetDataIndex(int visibleIndex) const
+{
+    if (!m_bSearching && !m_pBoundOrder)
+        return visibleIndex;
+
+    const auto& order = m_bSearching ? m_SearchIndex.GetMatches() : *m_pBoundOrder;
+
+    // Past the end of the data, so callers bounds checks fail
+    if (visibleIndex < 0 || visibleIndex >= static_cast<int>(order.size()))
+        return static_cast<int>(Data().size());
+
+    // Search matches are positions in the bound order, which may leave entries out
+    if (m_bSearching && m_pBoundOrder)
+        return static_cast<int>((*m_pBoundOrder)[order[visibleIndex]]);
+
+    return static_cast<int>(order[visibleIndex]);
+}
+
+template<typename T>
+inline void Selector<T>::BuildSearchIndex()
 {
+    m_SearchIndex.Clear();
+
+    if (m_pBoundOrder)
+    {
+        m_SearchIndex.Reserve(m_pBoundOrder->size());
+
+        for (size_t index : *m_pBoundOrder)
+            m_SearchIndex.AddName(m_GetSearchName(Data()[index]));
+    }
+    else
+    {
+        m_SearchIndex.Reserve(Data().size());
+
+        for (const auto& item : Data())
+            m_SearchIndex.AddName(m_GetSearchName(item));
+    }
+
+    m_bSearchIndexDirty = false;
+}
+
+template<typename T>
+inline void Selector<T>::OnSearchChanged()
+{
+    m_Params.currentX = 0;
+    m_Params.currentY = 0;
+    UpdateRows();
+    m_Console.ClearBuffer();
+}
+
+template<typename T>
+inline void Selector<T>::ProcessSearchInputs()
+{
+    if (m_Keyboard.IsKeyJustPressed(KEY_F3))
+    {
+        StopSearch();
+        return;
+    }
+
+    bool changed = false;
+
+    if (m_Keyboard.IsKeyJustPressed(KEY_BACKSPACE))
+        changed = m_SearchIndex.Pop();
+
+    for (int key = KEY_A; key <= KEY_Z; key++)
+    {
+        if (!m_Keyboard.IsKeyJustPressed(key))
+            continue;
+
+        m_SearchIndex.Push(static_cast<wchar_t>(L'a' + (key - KEY_A)));
+        changed = true;
+    }
+
+    for (int key = KEY_0; key <= KEY_9; key++)
+    {
+        if (!m_Keyboard.IsKeyJustPressed(key))
+            continue;
+
+        m_SearchIndex.Push(static_cast<wchar_t>(L'0' + (key - KEY_0)));
+        changed = true;
+    }
+
+    if (m_Keyboard.IsKeyJustPressed(KEY_SPACE))
+    {
+        m_SearchIndex.Push(L' ');
+        changed = true;
+    }
+
+    if (changed)
+    {
+        OnSearchChanged();
+        return;
+    }
+
+    // Letters are taken by the search, so move with the arrow keys instead
+    if (m_Keyboard.IsKeyJustPressed(KEY_UP))
+        MoveUp();
+    else if (m_Keyboard.IsKeyJustPressed(KEY_DOWN))
+        MoveDown();
+    else if (m_Keyboard.IsKeyJustPressed(KEY_LEFT))
+        MoveLeft();
+    else if (m_Keyboard.IsKeyJustPressed(KEY_RIGHT))
+        MoveRight();
+    else if (m_Keyboard.IsKeyJustPressed(KEY_ENTER))
+        OnAction();
 }
 
 template<typename T>
 inline void Selector<T>::ProcessInputs()
 {
+    if (m_bSearching)
+    {
+        ProcessSearchInputs();
+        return;
+    }
+
+    if (m_GetSearchName && m_Keyboard.IsKeyJustPressed(KEY_F3))
+    {
+        if (m_bSearchIndexDirty)
+            BuildSearchIndex();
+
+        m_bSearching = true;
+        OnSearchChanged();
+        return;
+    }
+
     if (m_Keyboard.IsKeyJustPressed(KEY_W))
         MoveUp();
     else if (m_Keyboard.IsKeyJustPressed(KEY_S))
@@ -148,7 +379,11 @@ template<typename T>
 inline void Selector<T>::OnAction()
 {
     int index = GetIndex();
-    m_OnSelection(index, m_Data);
+
+    if (index >= static_cast<int>(Data().size()))
+        return;
+
+    m_OnSelection(index, Data());
 }
 
 template<typename T>
@@ -173,7 +408,10 @@ inline void Selector<T>::OnSelection(int index, std::vector<T> data)
 template<typename T>
 inline void Selector<T>::Draw()
 {
-    if (m_Data.empty())
+    if (m_bSearching)
+        m_Console.Write(m_SearchX, m_SearchY, L"SEARCH: " + m_SearchIndex.GetQuery() + L"_", LIGHT_BLUE);
+
+    if (Data().empty())
         return;
 
     int itemIndex = 0;
@@ -182,7 +420,7 @@ inline void Selector<T>::Draw()
     int rowHeight = m_Params.spacingY;
     int spacingX = m_Params.spacingX;
 
-    int maxData = m_Data.size();
+    int maxData = GetNumVisible();
 
     for (int i = 0; i < m_Rows; i++)
     {
@@ -209,7 +447,7 @@ inline void Selector<T>::Draw()
 
             if (itemIndex < maxData)
             {
-                T item = m_Data[itemIndex];
+                T item = Data()[GetDataIndex(itemIndex)];
                 m_OnDrawItem(x, y, item);
                 x += spacingX;
                 itemIndex++;
@@ -1,6 +1,16 @@
 #include "Stats.h"
 #include "Logger.h"
-#include <iostream>
+#include "utility/StatFormula.h"
+
+namespace
+{
+	inline bool IsValidSlot(Stats::EquipSlots slot)
+	{
+		return static_cast<size_t>(slot) < Stats::NUM_EQUIP_SLOTS;
+	}
+
+	ModifierSource g_NextModifierSource{ Stats::NO_SOURCE + 1 };
+}
 
 Stats::Stats()
 	: Stats(0, 0, 0, 0, 0)
@@ -9,115 +19,203 @@ Stats::Stats()
 }
 
 Stats::Stats(int strength, int intelligence, int speed, int willpower, int stamina)
-	: m_StatList{
-		{L"Attack", 0},
-		{L"Defense", 0},
-		{L"Magic", 0},
-		{L"Strength", strength},
-		{L"Speed", speed},
-		{L"Intelligence", intelligence},
-		{L"WillPower", willpower},
-		{L"Stamina", stamina},
-	},
-m_StatModifierList{
-		{L"Strength", 0},
-		{L"Speed", 0},
-		{L"Intelligence", 0},
-		{L"WillPower", 0},
-		{L"Stamina", 0},
-	},
-	m_EquipSlotList{
-		{EquipSlots::WEAPON, 0},
-		{EquipSlots::HEADGEAR, 0},
-		{EquipSlots::CHEST_BODY, 0},
-		{EquipSlots::FOOTWEAR, 0},
-		{EquipSlots::RELIC, 0},
-
-}
-{
-	//initialise
-	UpdateStats();
-}
-
-const int Stats::GetStat(const std::wstring& key)
-{
-	if (m_StatList.find(key) == m_StatList.end())
+	: m_StatList{}, m_Modifiers{}, m_ModifierAdd{}, m_ModifierPercent{}, m_EquipSlotList{}, m_DirtyStats{ (1u << NUM_STATS) - 1 }
+{
+	SetStat(StatId::STRENGTH, strength);
+	SetStat(StatId::SPEED, speed);
+	SetStat(StatId::INTELLIGENCE, intelligence);
+	SetStat(StatId::WILLPOWER, willpower);
+	SetStat(StatId::STAMINA, stamina);
+}
+
+const int Stats::GetStat(const std::wstring& key) const
+{
+	const StatId stat = GetStatId(key);
+	if (stat == StatId::NUM_STATS)
 	{
-		//TRPG_ERROR("[" + key + "] -- Is not valid!");
-		std::wcout << L"[" + key + L"] -- Is not valid!\n";
+		TRPG_ERROR("Stat name is not valid!");
 		return 0;
 	}
-	return m_StatList[key];
+	return GetStat(stat);
 }
 
-const int Stats::GetModifier(const std::wstring& key)
+const int Stats::GetModifier(const std::wstring& key) const
 {
-		if (m_StatModifierList.find(key) == m_StatModifierList.end())
-		{
-			//TRPG_ERROR("[" + key + "] -- Is not valid!");
-			std::wcout << L"[" + key + L"] -- Is not valid!\n";
-			return 0;
-		}
-		return m_StatModifierList[key];
+	const StatId stat = GetStatId(key);
+	if (stat == StatId::NUM_STATS)
+	{
+		TRPG_ERROR("Stat name is not valid!");
+		return 0;
+	}
+	return GetModifier(stat);
 }
 
-const int Stats::GetEquipmentValue(EquipSlots slot)
+const int Stats::GetEquipmentValue(EquipSlots slot) const
 {
-	if (m_EquipSlotList.find(slot) == m_EquipSlotList.end())
+	if (!IsValidSlot(slot))
 	{
-		//TRPG_ERROR("[" + key + "] -- Is not valid!");
-		std::wcout << L"--Invalid slot!\n";
+		TRPG_ERROR("Invalid slot!");
 		return 0;
 	}
-	return m_EquipSlotList[slot];
+	return m_EquipSlotList[static_cast<size_t>(slot)];
 }
 
-void Stats::SetModifier(const std::wstring& key, int value)
+ModifierSource Stats::CreateModifierSource()
+{
+	return g_NextModifierSource++;
+}
+
+void Stats::ApplyModifier(const ModifierEntry& modifier, int sign)
+{
+	const size_t index = static_cast<size_t>(modifier.stat);
+
+	if (modifier.layer == ModifierLayer::ADD)
+		m_ModifierAdd[index] += sign * modifier.value;
+	else
+		m_ModifierPercent[index] += sign * modifier.value;
+
+	MarkDependentsDirty(GetStatInput(modifier.stat));
+}
+
+void Stats::AddModifier(ModifierSource source, StatId stat, int value, ModifierLayer layer)
+{
+	if (static_cast<size_t>(stat) >= NUM_STATS)
+	{
+		TRPG_ERROR("Stat is not valid!");
+		return;
+	}
+
+	for (auto& modifier : m_Modifiers)
+	{
+		if (modifier.source != source || modifier.stat != stat || modifier.layer != layer)
+			continue;
+
+		if (modifier.value == value)
+			return;
+
+		ApplyModifier(modifier, -1);
+		modifier.value = value;
+		ApplyModifier(modifier, 1);
+		return;
+	}
+
+	const ModifierEntry& modifier = m_Modifiers.emplace_back(ModifierEntry{ source, stat, layer, value });
+	ApplyModifier(modifier, 1);
+}
+
+void Stats::RemoveModifier(ModifierSource source, StatId stat, ModifierLayer layer)
 {
+	for (size_t i = 0; i < m_Modifiers.size(); i++)
+	{
+		const auto& modifier = m_Modifiers[i];
+		if (modifier.source != source || modifier.stat != stat || modifier.layer != layer)
+			continue;
+
+		ApplyModifier(modifier, -1);
+		m_Modifiers[i] = m_Modifiers.back();
+		m_Modifiers.pop_back();
+		return;
+	}
+}
 
-	if (m_StatModifierList.find(key) == m_StatModifierList.end())
+void Stats::RemoveModifiers(ModifierSource source)
+{
+	for (size_t i = 0; i < m_Modifiers.size();)
 	{
-		//TRPG_ERROR("[" + key + "] -- Is not valid!");
-		std::wcout << L"[" + key + L"] --Is not valid!\n";
+		if (m_Modifiers[i].source != source)
+		{
+			i++;
+			continue;
+		}
+
+		ApplyModifier(m_Modifiers[i], -1);
+		m_Modifiers[i] = m_Modifiers.back();
+		m_Modifiers.pop_back();
+	}
+}
+
+void Stats::SetModifier(StatId stat, int value)
+{
+	if (value == 0)
+		RemoveModifier(NO_SOURCE, stat);
+	else
+		AddModifier(NO_SOURCE, stat, value);
+}
+
+void Stats::SetStat(StatId stat, int value)
+{
+	const size_t index = static_cast<size_t>(stat);
+
+	// Setting a derived stat overrides it until one of its inputs changes
+	m_DirtyStats &= ~(1u << static_cast<uint32_t>(stat));
+
+	if (m_StatList[index] == value)
+		return;
+
+	m_StatList[index] = value;
+	MarkDependentsDirty(GetStatInput(stat));
+}
+
+void Stats::SetModifier(const std::wstring& key, int value)
+{
+	const StatId stat = GetStatId(key);
+	if (stat == StatId::NUM_STATS)
+	{
+		TRPG_ERROR("Stat name is not valid!");
 		return;
 	}
-	m_StatModifierList[key] = value;
+	SetModifier(stat, value);
 }
 
 void Stats::SetEquipmentValue(EquipSlots slot, int value)
 {
-	if (m_EquipSlotList.find(slot) == m_EquipSlotList.end())
+	if (!IsValidSlot(slot))
 	{
-		//TRPG_ERROR("[" + key + "] -- Is not valid!");
-		std::wcout << L"--Invalid slot!\n";
+		TRPG_ERROR("Invalid slot!");
 		return;
 	}
-	m_EquipSlotList[slot] = value ;
+	const size_t index = static_cast<size_t>(slot);
+	if (m_EquipSlotList[index] == value)
+		return;
+
+	m_EquipSlotList[index] = value;
+	MarkDependentsDirty(GetStatInput(slot));
 }
 
 void Stats::SetStat(const std::wstring& key, int value)
 {
-	if (m_StatList.find(key) == m_StatList.end())
+	const StatId stat = GetStatId(key);
+	if (stat == StatId::NUM_STATS)
 	{
-		//TRPG_ERROR("[" + key + "] -- Is not valid!");
-		std::wcout << L"[" + key + L"] -- Is not valid!\n";
+		TRPG_ERROR("Stat name is not valid!");
 		return;
 	}
-	 m_StatList[key] = value;
+	SetStat(stat, value);
+}
+
+void Stats::MarkDependentsDirty(size_t input)
+{
+	m_DirtyStats |= StatFormulas::GetInstance().GetDependents(input);
 }
 
-void Stats::UpdateStats()
+void Stats::Recompute(StatId stat) const
 {
+	const StatFormula* formula = StatFormulas::GetInstance().Get(stat);
 
-	m_StatList[L"Attack"] = m_EquipSlotList[EquipSlots::WEAPON] + (m_StatList[L"Strength"] + m_StatModifierList[L"Strength"]) +
-		((m_StatList[L"Intelligence"] + m_StatModifierList[L"Intelligence"]) / 5) +
-		((m_StatList[L"WillPower"] + m_StatModifierList[L"WillPower"]) / 5);
-	
-	//defense stats
+	// Cleared first, so a formula reading its own stat sees the cached value instead of recursing
+	m_DirtyStats &= ~(1u << static_cast<uint32_t>(stat));
 
-	m_StatList[L"Defense"] = m_EquipSlotList[EquipSlots::HEADGEAR] + m_EquipSlotList[EquipSlots::CHEST_BODY] + m_EquipSlotList[EquipSlots::FOOTWEAR] +
-		((m_StatList[L"Strength"] + m_StatModifierList[L"Strength"]) / 5 ) +
-		((m_StatList[L"Intelligence"] + m_StatModifierList[L"Intelligence"]) / 5) +
-		((m_StatList[L"Speed"] + m_StatModifierList[L"Speed"]) / 5) +
-		((m_StatList[L"WillPower"] + m_StatModifierList[L"WillPower"]) / 5);
-}
\ No newline at end of file
+	if (formula)
+		m_StatList[static_cast<size_t>(stat)] = formula->Evaluate(*this);
+}
+
+void Stats::UpdateStats() const
+{
+	const uint32_t dirty = m_DirtyStats & StatFormulas::GetInstance().GetDerivedStats();
+
+	for (size_t stat = 0; stat < NUM_STATS; stat++)
+	{
+		if (dirty & (1u << stat))
+			Recompute(static_cast<StatId>(stat));
+	}
+}
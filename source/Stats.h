@@ -1,35 +1,124 @@
 #pragma once
 
-#include <unordered_map>
+#include <array>
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <vector>
 
+enum class StatId : uint8_t { ATTACK = 0, DEFENSE, MAGIC, STRENGTH, SPEED, INTELLIGENCE, WILLPOWER, STAMINA, NUM_STATS };
+
+constexpr size_t NUM_STATS = static_cast<size_t>(StatId::NUM_STATS);
+
+// Display names, indexed by StatId
+constexpr std::array<std::wstring_view, NUM_STATS> STAT_NAMES{
+    L"Attack", L"Defense", L"Magic", L"Strength", L"Speed", L"Intelligence", L"WillPower", L"Stamina"
+};
+
+inline constexpr std::wstring_view GetStatName(StatId stat) { return STAT_NAMES[static_cast<size_t>(stat)]; }
+
+// Returns StatId::NUM_STATS when the name is not a stat
+constexpr StatId GetStatId(std::wstring_view name)
+{
+    for (size_t i = 0; i < NUM_STATS; i++)
+    {
+        if (STAT_NAMES[i] == name)
+            return static_cast<StatId>(i);
+    }
+
+    return StatId::NUM_STATS;
+}
+
+// Identifies what applied a modifier (an equipment instance, a status effect, a buff) so it can be removed again
+using ModifierSource = uint32_t;
+
+// Additive modifiers are summed first, then the percentages are summed and applied once to the result
+enum class ModifierLayer { ADD = 0, PERCENT };
+
+/*
+* Stats and modifiers are stored in arrays indexed by StatId, so reading a stat is a single load.
+* Derived stats (Attack, Defense) are cached. Changing an input only marks the derived stats that read it as dirty,
+* and a dirty stat is recomputed the next time it is read.
+* Modifiers stack, each is kept with its source and the sum of each layer is cached per stat, so adding or removing one
+* and reading a total are both O(1).
+* The std::wstring overloads look the name up first and are only kept for older callers.
+*/
 class Stats
 {
 public:
     enum class EquipSlots { WEAPON = 0, HEADGEAR, CHEST_BODY, FOOTWEAR, RELIC, NO_SLOT };
+    static const size_t NUM_EQUIP_SLOTS = static_cast<size_t>(EquipSlots::NO_SLOT);
+    // The source of the modifiers set through SetModifier
+    static const ModifierSource NO_SOURCE = 0;
 
 private:
-    std::unordered_map<std::wstring, int> m_StatList;
-    std::unordered_map<std::wstring, int> m_StatModifierList;
-    std::unordered_map<EquipSlots, int> m_EquipSlotList;
+    struct ModifierEntry
+    {
+        ModifierSource source;
+        StatId stat;
+        ModifierLayer layer;
+        int value;
+    };
+
+    // Recomputing a derived stat on read does not change what the stats are, so the cache is mutable
+    mutable std::array<int, NUM_STATS> m_StatList;
+    std::vector<ModifierEntry> m_Modifiers;
+    std::array<int, NUM_STATS> m_ModifierAdd;
+    std::array<int, NUM_STATS> m_ModifierPercent;
+    std::array<int, NUM_EQUIP_SLOTS> m_EquipSlotList;
+    // One bit per StatId, set when a derived stat's inputs changed since it was computed
+    mutable uint32_t m_DirtyStats;
+
+    void MarkDependentsDirty(size_t input);
+    void Recompute(StatId stat) const;
+    void ApplyModifier(const ModifierEntry& modifier, int sign);
 
 public:
     Stats();
     Stats(int strength, int intelligence, int speed, int dexterity, int stamina);
     ~Stats() = default;
 
-    inline const std::unordered_map<std::wstring, int>& GetStatList() const { return m_StatList; }
-    inline const std::unordered_map<std::wstring, int>& GetStatsList() const { return m_StatList; } 
-    inline const std::unordered_map<std::wstring, int>& GetModifierList() const { return m_StatModifierList; }
-    inline const std::unordered_map<EquipSlots, int>& GetEquipSlotList() const { return m_EquipSlotList; }
+    inline const std::array<int, NUM_STATS>& GetStatList() const { UpdateStats(); return m_StatList; }
+    inline const std::array<int, NUM_STATS>& GetStatsList() const { return GetStatList(); }
+    inline const std::array<int, NUM_EQUIP_SLOTS>& GetEquipSlotList() const { return m_EquipSlotList; }
+
+    inline const int GetStat(StatId stat) const
+    {
+        if (m_DirtyStats & (1u << static_cast<uint32_t>(stat)))
+            Recompute(stat);
+
+        return m_StatList[static_cast<size_t>(stat)];
+    }
+    // The stat with all of its modifiers applied
+    inline const int GetTotal(StatId stat) const
+    {
+        const size_t index = static_cast<size_t>(stat);
+        const int total = GetStat(stat) + m_ModifierAdd[index];
+        return m_ModifierPercent[index] == 0 ? total : total * (100 + m_ModifierPercent[index]) / 100;
+    }
+    // How much the modifiers add to the stat
+    inline const int GetModifier(StatId stat) const { return GetTotal(stat) - GetStat(stat); }
+
+    const int GetStat(const std::wstring& key) const;
+    const int GetModifier(const std::wstring& key) const;
+    const int GetEquipmentValue(EquipSlots slot) const;
+
+    // Gives the system that applies modifiers (an equipment instance, a status effect) a handle of its own
+    static ModifierSource CreateModifierSource();
 
-    const int GetStat(const std::wstring& key);
-    const int GetModifier(const std::wstring& key);
-    const int GetEquipmentValue(EquipSlots slot);
+    // A source has at most one modifier per stat and layer, adding it again replaces the value
+    void AddModifier(ModifierSource source, StatId stat, int value, ModifierLayer layer = ModifierLayer::ADD);
+    void RemoveModifier(ModifierSource source, StatId stat, ModifierLayer layer = ModifierLayer::ADD);
+    // Removes every modifier the source applied
+    void RemoveModifiers(ModifierSource source);
 
+    // Replaces the additive modifier from NO_SOURCE, kept for callers that do not track a source
+    void SetModifier(StatId stat, int value);
+    void SetStat(StatId stat, int value);
     void SetModifier(const std::wstring& key, int value);
     void SetEquipmentValue(EquipSlots slot, int value);
     void SetStat(const std::wstring& key, int value);
 
-    void UpdateStats();
+    // Recomputes every dirty derived stat now instead of on its next read
+    void UpdateStats() const;
 };
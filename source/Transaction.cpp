@@ -0,0 +1,53 @@
+#include "Transaction.h"
+
+Transaction::Transaction()
+    : m_Lines{}
+{
+}
+
+Transaction::Line& Transaction::GetLine(const Item::Definition* item, const Equipment::Definition* equipment)
+{
+    for (auto& line : m_Lines)
+    {
+        if (line.pItem == item && line.pEquipment == equipment)
+            return line;
+    }
+
+    return m_Lines.emplace_back(Line{ item, equipment, 0 });
+}
+
+void Transaction::AddItem(const Item::Definition& item, int count)
+{
+    if (count < 1)
+        return;
+
+    GetLine(&item, nullptr).count += count;
+}
+
+void Transaction::AddEquipment(const Equipment::Definition& equipment, int count)
+{
+    if (count < 1)
+        return;
+
+    GetLine(nullptr, &equipment).count += count;
+}
+
+const int Transaction::GetBuyPrice() const
+{
+    int price = 0;
+
+    for (const auto& line : m_Lines)
+        price += (line.pItem ? line.pItem->buyPrice : line.pEquipment->buyPrice) * line.count;
+
+    return price;
+}
+
+const int Transaction::GetSellPrice() const
+{
+    int price = 0;
+
+    for (const auto& line : m_Lines)
+        price += (line.pItem ? line.pItem->sellPrice : line.pEquipment->sellPrice) * line.count;
+
+    return price;
+}
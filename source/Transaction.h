@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Item.h"
+#include "Equipment.h"
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+/*
+* A cart of item and equipment definitions with a count of each, bought, sold or moved between inventories as one.
+* Inventory and Party check every line before they change anything, so a transaction either
+* happens completely or not at all.
+*/
+class Transaction
+{
+public:
+    enum class Result : uint8_t { OK = 0, EMPTY, NOT_ENOUGH_GOLD, TOO_MUCH_GOLD, STACK_FULL, NOT_ENOUGH_ITEMS, SAME_INVENTORY, CAN_NOT_CREATE };
+
+    // Messages for the player, indexed by Result
+    static constexpr std::array<std::wstring_view, 8> RESULT_MESSAGES{
+        L"Done!", L"Nothing was selected!", L"Not enough gold!", L"Can not carry any more gold!",
+        L"Can not carry that many!", L"Not enough to do that!", L"It is already there!", L"That can not be carried yet!"
+    };
+
+    // Only one of the definitions is set
+    struct Line
+    {
+        const Item::Definition* pItem;
+        const Equipment::Definition* pEquipment;
+        int count;
+    };
+
+private:
+    // At most one line per definition
+    std::vector<Line> m_Lines;
+
+    Line& GetLine(const Item::Definition* item, const Equipment::Definition* equipment);
+
+public:
+    Transaction();
+    ~Transaction() = default;
+
+    // Counts below one are ignored
+    void AddItem(const Item::Definition& item, int count = 1);
+    void AddEquipment(const Equipment::Definition& equipment, int count = 1);
+    inline void Clear() { m_Lines.clear(); }
+
+    inline const std::vector<Line>& GetLines() const { return m_Lines; }
+    inline const bool Empty() const { return m_Lines.empty(); }
+
+    const int GetBuyPrice() const;
+    const int GetSellPrice() const;
+
+    static inline const std::wstring_view GetMessage(Result result) { return RESULT_MESSAGES[static_cast<size_t>(result)]; }
+};
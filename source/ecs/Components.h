@@ -0,0 +1,51 @@
+#pragma once
+
+#include "../Stats.h"
+#include "../utility/StringTable.h"
+#include <array>
+#include <memory>
+#include <string>
+
+class Equipment;
+
+enum class ActorType { WARRIOR = 0, MAGE, ASSASSIN, KNIGHT };
+
+struct NameComponent
+{
+    InternedString name;
+    InternedString id;
+};
+
+struct LevelComponent
+{
+    int level;
+    int xp;
+    int xpToNextLevel;
+};
+
+struct HealthComponent
+{
+    int hp;
+    int maxHp;
+    bool dead;
+};
+
+struct ManaComponent
+{
+    int mp;
+    int maxMp;
+};
+
+struct ActorTypeComponent
+{
+    ActorType type;
+};
+
+// What is in each equipment slot, indexed by Stats::EquipSlots
+struct EquipmentComponent
+{
+    std::array<std::shared_ptr<Equipment>, Stats::NUM_EQUIP_SLOTS> slots;
+
+    inline std::shared_ptr<Equipment>& operator[](Stats::EquipSlots slot) { return slots[static_cast<size_t>(slot)]; }
+    inline const std::shared_ptr<Equipment>& operator[](Stats::EquipSlots slot) const { return slots[static_cast<size_t>(slot)]; }
+};
@@ -0,0 +1,148 @@
+#include "World.h"
+#include "../Logger.h"
+#include <cstdlib>
+
+size_t ComponentTypes::NextType()
+{
+    static size_t next_type = 0;
+
+    if (next_type >= MAX_COMPONENT_TYPES)
+    {
+        TRPG_ERROR("Too many component types!");
+        std::abort();
+    }
+
+    return next_type++;
+}
+
+Archetype::Archetype(ComponentMask mask)
+    : m_Mask{ mask }, m_Entities{}, m_Columns{}
+{
+}
+
+Entity Archetype::RemoveRow(size_t row)
+{
+    for (auto& column : m_Columns)
+    {
+        if (column)
+            column->SwapRemove(row);
+    }
+
+    const bool moved = row + 1 < m_Entities.size();
+    if (moved)
+        m_Entities[row] = m_Entities.back();
+    m_Entities.pop_back();
+
+    return moved ? m_Entities[row] : NULL_ENTITY;
+}
+
+std::unique_ptr<World> World::m_pInstance = nullptr;
+
+World::World()
+    : m_Entities{}, m_FreeEntities{}, m_Archetypes{}, m_ArchetypeMap{}
+{
+    GetArchetype(0, nullptr, {});
+}
+
+World& World::GetInstance()
+{
+    if (!m_pInstance)
+        m_pInstance.reset(new World());
+
+    return *m_pInstance;
+}
+
+Archetype& World::GetArchetype(ComponentMask mask, const Archetype* base, std::initializer_list<ColumnFactory> added)
+{
+    if (auto it = m_ArchetypeMap.find(mask); it != m_ArchetypeMap.end())
+        return *it->second;
+
+    auto archetype = std::make_unique<Archetype>(mask);
+
+    if (base)
+    {
+        for (size_t type = 0; type < MAX_COMPONENT_TYPES; type++)
+        {
+            if ((mask & (ComponentMask{ 1 } << type)) && base->GetColumn(type))
+                archetype->SetColumn(type, base->GetColumn(type)->CreateEmpty());
+        }
+    }
+
+    for (const ColumnFactory& factory : added)
+        archetype->SetColumn(factory.type, factory.create());
+
+    Archetype& result = *archetype;
+    m_ArchetypeMap.emplace(mask, archetype.get());
+    m_Archetypes.push_back(std::move(archetype));
+    return result;
+}
+
+Entity World::AllocateEntity(Archetype& archetype)
+{
+    uint32_t index;
+
+    if (!m_FreeEntities.empty())
+    {
+        index = m_FreeEntities.back();
+        m_FreeEntities.pop_back();
+    }
+    else
+    {
+        index = static_cast<uint32_t>(m_Entities.size());
+        m_Entities.push_back({ nullptr, 0, 0 });
+    }
+
+    EntityRecord& record = m_Entities[index];
+    record.archetype = &archetype;
+    record.row = archetype.GetEntities().size();
+
+    const Entity entity{ index, record.generation };
+    archetype.GetEntities().push_back(entity);
+    return entity;
+}
+
+Entity World::CreateEntity()
+{
+    return AllocateEntity(GetArchetype(0, nullptr, {}));
+}
+
+void World::DestroyEntity(Entity entity)
+{
+    EntityRecord* record = GetRecord(entity);
+    if (!record)
+    {
+        TRPG_LOGF(LogLevel::WARN, LogCategory::GENERAL, "Entity [{}] is already destroyed", entity.index);
+        return;
+    }
+
+    const Entity moved = record->archetype->RemoveRow(record->row);
+    if (moved != NULL_ENTITY)
+        m_Entities[moved.index].row = record->row;
+
+    record->archetype = nullptr;
+    record->generation++;
+    m_FreeEntities.push_back(entity.index);
+}
+
+void World::MoveEntity(Entity entity, Archetype& archetype)
+{
+    EntityRecord& record = m_Entities[entity.index];
+    Archetype& source = *record.archetype;
+
+    for (size_t type = 0; type < MAX_COMPONENT_TYPES; type++)
+    {
+        IComponentColumn* from = source.GetColumn(type);
+        IComponentColumn* to = archetype.GetColumn(type);
+
+        if (from && to)
+            from->MoveRowTo(record.row, *to);
+    }
+
+    const Entity moved = source.RemoveRow(record.row);
+    if (moved != NULL_ENTITY)
+        m_Entities[moved.index].row = record.row;
+
+    record.archetype = &archetype;
+    record.row = archetype.GetEntities().size();
+    archetype.GetEntities().push_back(entity);
+}
@@ -0,0 +1,265 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// The index is reused after an entity is destroyed, the generation tells the old and new entity apart
+struct Entity
+{
+    uint32_t index;
+    uint32_t generation;
+
+    bool operator==(const Entity& other) const = default;
+};
+
+constexpr Entity NULL_ENTITY{ UINT32_MAX, 0 };
+
+// One bit per component type
+using ComponentMask = uint64_t;
+constexpr size_t MAX_COMPONENT_TYPES = 64;
+
+// Lets an archetype move and remove rows without knowing the type of its components
+class IComponentColumn
+{
+public:
+    virtual ~IComponentColumn() {}
+    virtual std::unique_ptr<IComponentColumn> CreateEmpty() const = 0;
+    // Moves the component in row to the end of other, which holds the same type
+    virtual void MoveRowTo(size_t row, IComponentColumn& other) = 0;
+    // Moves the last component into row
+    virtual void SwapRemove(size_t row) = 0;
+};
+
+template <typename T>
+class ComponentColumn : public IComponentColumn
+{
+private:
+    std::vector<T> m_Data;
+
+public:
+    std::unique_ptr<IComponentColumn> CreateEmpty() const override { return std::make_unique<ComponentColumn<T>>(); }
+
+    void MoveRowTo(size_t row, IComponentColumn& other) override
+    {
+        static_cast<ComponentColumn<T>&>(other).m_Data.push_back(std::move(m_Data[row]));
+    }
+
+    void SwapRemove(size_t row) override
+    {
+        if (row + 1 < m_Data.size())
+            m_Data[row] = std::move(m_Data.back());
+        m_Data.pop_back();
+    }
+
+    inline std::vector<T>& GetData() { return m_Data; }
+};
+
+class ComponentTypes
+{
+private:
+    static size_t NextType();
+
+public:
+    template <typename T>
+    static size_t Get()
+    {
+        static const size_t type = NextType();
+        return type;
+    }
+
+    template <typename T>
+    static ComponentMask GetMask() { return ComponentMask{ 1 } << Get<T>(); }
+
+    template <typename T>
+    static std::unique_ptr<IComponentColumn> CreateColumn() { return std::make_unique<ComponentColumn<T>>(); }
+};
+
+// How to create the column of a component type an archetype does not have yet
+struct ColumnFactory
+{
+    size_t type;
+    std::unique_ptr<IComponentColumn>(*create)();
+
+    template <typename T>
+    static ColumnFactory Of() { return { ComponentTypes::Get<T>(), &ComponentTypes::CreateColumn<T> }; }
+};
+
+/*
+* Every entity with exactly the same set of components, each component type stored in its own contiguous column.
+* Row i of every column belongs to the i-th entity.
+*/
+class Archetype
+{
+private:
+    ComponentMask m_Mask;
+    std::vector<Entity> m_Entities;
+    std::array<std::unique_ptr<IComponentColumn>, MAX_COMPONENT_TYPES> m_Columns;
+
+public:
+    explicit Archetype(ComponentMask mask);
+
+    inline const ComponentMask GetMask() const { return m_Mask; }
+    inline const std::vector<Entity>& GetEntities() const { return m_Entities; }
+    inline std::vector<Entity>& GetEntities() { return m_Entities; }
+    inline IComponentColumn* GetColumn(size_t type) const { return m_Columns[type].get(); }
+    inline void SetColumn(size_t type, std::unique_ptr<IComponentColumn> column) { m_Columns[type] = std::move(column); }
+
+    template <typename T>
+    inline std::vector<T>& GetData() const
+    {
+        return static_cast<ComponentColumn<T>*>(m_Columns[ComponentTypes::Get<T>()].get())->GetData();
+    }
+
+    // Removes the entity in row from every column, returns the entity that was moved into row or NULL_ENTITY
+    Entity RemoveRow(size_t row);
+};
+
+/*
+* Archetype based entity component system for actors, enemies and NPCs.
+* Components are plain structs, all entities with the same components share an archetype so a query walks
+* a few contiguous arrays instead of chasing a pointer per entity.
+* References to components stay valid until the next entity is created or destroyed, or a component is
+* added or removed; components must not be added or removed from inside Each.
+*/
+class World
+{
+private:
+    struct EntityRecord
+    {
+        Archetype* archetype;
+        size_t row;
+        uint32_t generation;
+    };
+
+    std::vector<EntityRecord> m_Entities;
+    std::vector<uint32_t> m_FreeEntities;
+    std::vector<std::unique_ptr<Archetype>> m_Archetypes;
+    std::unordered_map<ComponentMask, Archetype*> m_ArchetypeMap;
+
+    static std::unique_ptr<World> m_pInstance;
+
+    World();
+
+    // Finds the archetype for mask, creating it from base's columns and the added ones if it does not exist yet
+    Archetype& GetArchetype(ComponentMask mask, const Archetype* base, std::initializer_list<ColumnFactory> added);
+    Entity AllocateEntity(Archetype& archetype);
+    // Moves the entity's shared components to archetype, components only the old archetype has are destroyed
+    void MoveEntity(Entity entity, Archetype& archetype);
+
+    inline EntityRecord* GetRecord(Entity entity)
+    {
+        if (entity.index >= m_Entities.size() || m_Entities[entity.index].generation != entity.generation)
+            return nullptr;
+
+        return &m_Entities[entity.index];
+    }
+
+public:
+    static World& GetInstance();
+
+    Entity CreateEntity();
+
+    template <typename... Ts>
+    Entity CreateEntity(Ts... components)
+    {
+        const ComponentMask mask = (ComponentTypes::GetMask<Ts>() | ...);
+        Archetype& archetype = GetArchetype(mask, nullptr, { ColumnFactory::Of<Ts>()... });
+
+        (archetype.GetData<Ts>().push_back(std::move(components)), ...);
+        return AllocateEntity(archetype);
+    }
+
+    void DestroyEntity(Entity entity);
+    inline bool IsAlive(Entity entity) { return GetRecord(entity) != nullptr; }
+
+    // Replaces the component if the entity already has one
+    template <typename T>
+    T* AddComponent(Entity entity, T component)
+    {
+        EntityRecord* record = GetRecord(entity);
+        if (!record)
+            return nullptr;
+
+        if (T* current = GetComponent<T>(entity))
+        {
+            *current = std::move(component);
+            return current;
+        }
+
+        Archetype& archetype = GetArchetype(record->archetype->GetMask() | ComponentTypes::GetMask<T>(), record->archetype,
+            { ColumnFactory::Of<T>() });
+
+        MoveEntity(entity, archetype);
+        archetype.GetData<T>().push_back(std::move(component));
+        return &archetype.GetData<T>().back();
+    }
+
+    template <typename T>
+    void RemoveComponent(Entity entity)
+    {
+        EntityRecord* record = GetRecord(entity);
+        if (!record || !HasComponent<T>(entity))
+            return;
+
+        MoveEntity(entity, GetArchetype(record->archetype->GetMask() & ~ComponentTypes::GetMask<T>(), record->archetype, {}));
+    }
+
+    template <typename T>
+    bool HasComponent(Entity entity)
+    {
+        const EntityRecord* record = GetRecord(entity);
+        return record && (record->archetype->GetMask() & ComponentTypes::GetMask<T>()) != 0;
+    }
+
+    // nullptr when the entity is destroyed or does not have the component
+    template <typename T>
+    T* GetComponent(Entity entity)
+    {
+        const EntityRecord* record = GetRecord(entity);
+        if (!record || !(record->archetype->GetMask() & ComponentTypes::GetMask<T>()))
+            return nullptr;
+
+        return &record->archetype->GetData<T>()[record->row];
+    }
+
+    // Calls fn(entity, components...) for every entity that has all of Ts, one archetype at a time
+    template <typename... Ts, typename Fn>
+    void Each(Fn&& fn)
+    {
+        const ComponentMask mask = (ComponentTypes::GetMask<Ts>() | ...);
+
+        for (const auto& archetype : m_Archetypes)
+        {
+            if ((archetype->GetMask() & mask) != mask)
+                continue;
+
+            const std::vector<Entity>& entities = archetype->GetEntities();
+
+            [&](Ts*... columns) {
+                for (size_t row = 0; row < entities.size(); row++)
+                    fn(entities[row], columns[row]...);
+            }(archetype->GetData<Ts>().data()...);
+        }
+    }
+
+    // Number of entities that have all of Ts
+    template <typename... Ts>
+    size_t Count() const
+    {
+        const ComponentMask mask = (ComponentTypes::GetMask<Ts>() | ... | 0);
+        size_t count = 0;
+
+        for (const auto& archetype : m_Archetypes)
+        {
+            if ((archetype->GetMask() & mask) == mask)
+                count += archetype->GetEntities().size();
+        }
+
+        return count;
+    }
+};
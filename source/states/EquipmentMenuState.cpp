@@ -12,6 +12,7 @@ using namespace std::placeholders;
 #include "StateMachine.h"
 #include "../Inputs/Keyboard.h"
 #include <cassert>
+#include "../Profiler.h"
 using namespace std::placeholders;
 
 void EquipmentMenuState::DrawEquipment()
@@ -46,16 +47,16 @@ void EquipmentMenuState::DrawPlayerInfo()
     const auto& name = m_Player.GetName();
     m_Console.Write(m_CenterScreenW - static_cast<int>(name.size() / 2), 12, name);
 
-    const auto& stats_list = m_Player.GetStats().GetStatsList();
+    const auto& stats = m_Player.GetStats();
 
-    int i = 0;
-    for (const auto& [stat, value] : stats_list)
+    for (size_t i = 0; i < NUM_STATS; i++)
     {
-        const auto& mod_value = m_Player.GetStats().GetModifier(stat);
-        m_Console.Write(STAT_LABEL_X_POS, STAT_LABEL_START_Y_POS + i, stat);
-        m_Console.Write(STAT_VAL_X_POS, STAT_LABEL_START_Y_POS + i, std::to_wstring(value + mod_value));
-        DrawStatModifier(STAT_PREDICT_X_POS, STAT_LABEL_START_Y_POS + i, stat, value);
-        i++;
+        const StatId stat = static_cast<StatId>(i);
+        const int y = STAT_LABEL_START_Y_POS + static_cast<int>(i);
+
+        m_Console.Write(STAT_LABEL_X_POS, y, GetStatName(stat));
+        m_Console.Write(STAT_VAL_X_POS, y, std::to_wstring(stats.GetTotal(stat)));
+        DrawStatModifier(STAT_PREDICT_X_POS, y, stat, stats.GetStat(stat));
     }
 }
 
@@ -111,7 +112,7 @@ void EquipmentMenuState::DrawStatPrediction()
     m_Console.Write(STAT_PREDICT_X_POS, m_DiffPosY, diff_dir + L" " + std::to_wstring(abs_diff_val), diff_colour);
 }
 
-void EquipmentMenuState::DrawStatModifier(int x, int y, const std::wstring& stat, int value)
+void EquipmentMenuState::DrawStatModifier(int x, int y, StatId stat, int value)
 {
     if (m_bInSlotSelect)
         return;
@@ -137,7 +138,7 @@ void EquipmentMenuState::DrawStatModifier(int x, int y, const std::wstring& stat
     if (stat_modifier.modifierType == StatModifier::ModifierType::NO_TYPE)
         return;
 
-    if (stat != stat_modifier.modifierTypeStr)
+    if (stat != stat_modifier.statId)
     {
         m_Console.Write(x, y, L"   ");
         return;
@@ -177,61 +178,23 @@ void EquipmentMenuState::OnEquipSelect(int index, std::vector<std::shared_ptr<Eq
     if (index > data.size() - 1 || data.empty())
         return;
 
+    // The replaced item's modifiers have to come off, the new item's are added on top of whatever is left
     const auto& equippedItem = m_Player.GetEquippedItemSlots()[m_eEquipSlots];
     if (equippedItem)
-        equippedItem->Remove();
+        equippedItem->OnRemove(m_Player);
 
     const auto& item = data[index];
 
     m_Player.GetEquippedItemSlots()[m_eEquipSlots] = nullptr;
     m_Player.GetEquippedItemSlots()[m_eEquipSlots] = item;
 
-    Equipment::EquipType equiptype = Equipment::EquipType::NO_TYPE;
-    ArmourProperties::ArmourType armour_type = ArmourProperties::ArmourType::NOT_ARMOUR;
-
-    switch (m_eEquipSlots)
-    {
-    case Stats::EquipSlots::WEAPON:
-        equiptype = Equipment::EquipType::WEAPON;
-        break;
-    case Stats::EquipSlots::HEADGEAR:
-        equiptype = Equipment::EquipType::ARMOUR;
-        armour_type = ArmourProperties::ArmourType::HEADGEAR;
-        break;
-    case Stats::EquipSlots::FOOTWEAR:
-        equiptype = Equipment::EquipType::ARMOUR;
-        armour_type = ArmourProperties::ArmourType::FOOTWEAR;
-        break;
-    case Stats::EquipSlots::CHEST_BODY:
-        equiptype = Equipment::EquipType::ARMOUR;
-        armour_type = ArmourProperties::ArmourType::CHEST_BODY;
-        break;
-    case Stats::EquipSlots::RELIC:
-        equiptype = Equipment::EquipType::RELIC;
-        break;
-    default:
-        break;
-    }
     if (!item->OnEquip(m_Player))
     {
         TRPG_ERROR("Failed to Equip!");
         return;
     }
-    std::vector<std::shared_ptr<Equipment>> selectedEquipment{};
-
-    for (const auto& item : m_Player.GetInventory().GetEquipment())
-    {
-        const auto& type = item->GetType();
-        if (type != equiptype || item->IsEquipped())
-            continue;
 
-        if (type == Equipment::EquipType::ARMOUR && item->GetArmourProperties().armourType != armour_type)
-            continue;
-
-        selectedEquipment.push_back(item);
-    }
-
-    m_EquipmentSelector.SetData(selectedEquipment);
+    SetSlotEquipment();
     m_Console.ClearBuffer();
 }
 
@@ -239,38 +202,27 @@ void EquipmentMenuState::OnSlotSelect(int index, std::vector<std::wstring> data)
 {
     const auto& slot_name = data[index];
 
-    Equipment::EquipType equiptype = Equipment::EquipType::NO_TYPE;
-    ArmourProperties::ArmourType armour_type = ArmourProperties::ArmourType::NOT_ARMOUR;
-
     if (slot_name == L"Weapon")
     {
         m_eEquipSlots = Stats::EquipSlots::WEAPON;
-        equiptype = Equipment::EquipType::WEAPON;
     }
     else if (slot_name == L"Headgear")
     {
         m_eEquipSlots = Stats::EquipSlots::HEADGEAR;
-        equiptype = Equipment::EquipType::ARMOUR;
-        armour_type = ArmourProperties::ArmourType::HEADGEAR;
     }
     else if (slot_name == L"Armour")
     {
         m_eEquipSlots = Stats::EquipSlots::CHEST_BODY;
-        equiptype = Equipment::EquipType::ARMOUR;
-        armour_type = ArmourProperties::ArmourType::CHEST_BODY;
         statPos = 1;
     }
     else if (slot_name == L"Footwear")
     {
         m_eEquipSlots = Stats::EquipSlots::FOOTWEAR;
-        equiptype = Equipment::EquipType::ARMOUR;
-        armour_type = ArmourProperties::ArmourType::FOOTWEAR;
         statPos = 1;
     }
     else if (slot_name == L"Relic")
     {
         m_eEquipSlots = Stats::EquipSlots::RELIC;
-        equiptype = Equipment::EquipType::ARMOUR;
     }
     else
     {
@@ -283,21 +235,7 @@ void EquipmentMenuState::OnSlotSelect(int index, std::vector<std::wstring> data)
         return;
     }
 
-    std::vector<std::shared_ptr<Equipment>> selectedEquipment{};
-
-    for (const auto& item : m_Player.GetInventory().GetEquipment())
-    {
-        const auto& type = item->GetType();
-        if (type != equiptype || item->IsEquipped())
-            continue;
-
-        if (type == Equipment::EquipType::ARMOUR && item->GetArmourProperties().armourType != armour_type)
-            continue;
-
-        selectedEquipment.push_back(item);
-    }
-
-    m_EquipmentSelector.SetData(selectedEquipment);
+    SetSlotEquipment();
 
     m_DiffPosY = STAT_LABEL_START_Y_POS + statPos;
     m_sCurrentSlot = slot_name;
@@ -307,34 +245,15 @@ void EquipmentMenuState::OnSlotSelect(int index, std::vector<std::wstring> data)
 
 }
 
-void EquipmentMenuState::RenderEquip(int x, int y, std::shared_ptr<Equipment> item)
+void EquipmentMenuState::SetSlotEquipment()
 {
-    if (item->IsEquipped())
-        return;
-
-    switch (item->GetType())
-    {
-    case Equipment::EquipType::ARMOUR:
-        if (item->GetArmourProperties().armourType == ArmourProperties::ArmourType::HEADGEAR && m_eEquipSlots != Stats::EquipSlots::HEADGEAR ||
-            item->GetArmourProperties().armourType == ArmourProperties::ArmourType::CHEST_BODY && m_eEquipSlots != Stats::EquipSlots::CHEST_BODY ||
-            item->GetArmourProperties().armourType == ArmourProperties::ArmourType::FOOTWEAR && m_eEquipSlots != Stats::EquipSlots::FOOTWEAR)
-        {
-            return;
-        }
-        break;
-    case Equipment::EquipType::WEAPON:
-        if (m_eEquipSlots != Stats::EquipSlots::WEAPON)
-            return;
-        break;
-    case Equipment::EquipType::RELIC:
-        if (m_eEquipSlots != Stats::EquipSlots::RELIC)
-            return;
-        break;
-    case Equipment::EquipType::NO_TYPE:
-        TRPG_LOG("THERE IS NO TYPE FOR EQUIPMENT");
-        return;
-    }
+    // The inventory keeps each slot's unequipped entries sorted by name, rebinding also picks up any changes to them
+    const auto& inventory = m_Player.GetInventory();
+    m_EquipmentSelector.BindData(inventory.GetEquipment(), inventory.GetEquipmentForSlot(m_eEquipSlots));
+}
 
+void EquipmentMenuState::RenderEquip(int x, int y, std::shared_ptr<Equipment> item)
+{
     const auto& name = item->GetName();
     m_Console.Write(x, y, name);
 
@@ -395,6 +314,9 @@ void EquipmentMenuState::RenderEquipSlots(int x, int y, const std::wstring& item
 
 void EquipmentMenuState::RemoveEquipment(int index, std::vector<std::wstring>& data)
 {
+    if (m_eEquipSlots == Stats::EquipSlots::NO_SLOT)
+        return;
+
     const auto& item = m_Player.GetEquippedItemSlots()[m_eEquipSlots];
 
     if (!item)
@@ -434,7 +356,7 @@ EquipmentMenuState::EquipmentMenuState(Player& player, Console& console, StateMa
         console, keyboard,
         std::bind(&EquipmentMenuState::OnEquipSelect, this, _1, _2),
         std::bind(&EquipmentMenuState::RenderEquip, this, _1, _2, _3),
-        player.GetInventory().GetEquipment(),
+        std::vector<std::shared_ptr<Equipment>>(),
         SelectorParams{30, 14, 2, 35, 2}
     }
     , m_bExitGame{ false }, m_bInMenuSelect{ true }, m_bInSlotSelect{ false }, m_bRemoveEquipment{ false }
@@ -446,6 +368,8 @@ EquipmentMenuState::EquipmentMenuState(Player& player, Console& console, StateMa
     m_MenuSelector.SetSelectionFunc(std::bind(&EquipmentMenuState::OnMenuSelect, this, _1, _2));
     m_EquipmentSelector.HideCursor();
     m_EquipSlotSelector.HideCursor();
+    m_EquipmentSelector.BindData(m_Player.GetInventory().GetEquipment(), m_Player.GetInventory().GetEquipmentForSlot(m_eEquipSlots));
+    m_EquipmentSelector.EnableSearch([](const std::shared_ptr<Equipment>& equipment) -> const std::wstring& { return equipment->GetName(); }, 30, 12);
 }
 
 EquipmentMenuState::~EquipmentMenuState()
@@ -454,21 +378,29 @@ EquipmentMenuState::~EquipmentMenuState()
 
 void EquipmentMenuState::OnEnter()
 {
+    TRPG_PROFILE_SCOPE("EquipmentMenuState::OnEnter");
+
     m_Console.ClearBuffer();
 }
 
 void EquipmentMenuState::OnExit()
 {
+    TRPG_PROFILE_SCOPE("EquipmentMenuState::OnExit");
+
     m_Console.ClearBuffer();
 }
 
 void EquipmentMenuState::Update()
 {
+    TRPG_PROFILE_SCOPE("EquipmentMenuState::Update");
+
     void UpdateIndex();
 }
 
 void EquipmentMenuState::Draw()
 {
+    TRPG_PROFILE_SCOPE("EquipmentMenuState::Draw");
+
     DrawEquipment(); // Draw the header and layout
 
     // Render the equipment slots
@@ -495,6 +427,8 @@ void EquipmentMenuState::Draw()
 
 void EquipmentMenuState::ProcessInputs()
 {
+    TRPG_PROFILE_SCOPE("EquipmentMenuState::ProcessInputs");
+
     if (m_bInMenuSelect)
     {
         if (m_Keyboard.IsKeyJustPressed(KEY_BACKSPACE))
@@ -522,7 +456,7 @@ void EquipmentMenuState::ProcessInputs()
     }
     else
     {
-        if (m_Keyboard.IsKeyJustPressed(KEY_BACKSPACE))
+        if (!m_EquipmentSelector.IsSearching() && m_Keyboard.IsKeyJustPressed(KEY_BACKSPACE))
         {
             m_EquipSlotSelector.ShowCursor();
             m_EquipmentSelector.HideCursor();
@@ -539,5 +473,7 @@ void EquipmentMenuState::ProcessInputs()
 
 bool EquipmentMenuState::Exit()
 {
+    TRPG_PROFILE_SCOPE("EquipmentMenuState::Exit");
+
     return m_bExitGame;
 }
@@ -49,7 +49,7 @@ private:
     void DrawEquipment();
     void DrawPlayerInfo();
     void DrawStatPrediction();
-    void DrawStatModifier(int x, int y, const std::wstring& stat, int value);
+    void DrawStatModifier(int x, int y, StatId stat, int value);
 
     void OnMenuSelect(int index, std::vector<std::wstring> data);
     void OnEquipSelect(int index, std::vector<std::shared_ptr<Equipment>> data);
@@ -57,6 +57,7 @@ private:
     void RenderEquip(int x, int y, std::shared_ptr<Equipment> item);
     void RenderEquipSlots(int x, int y, const std::wstring& item);
 
+    void SetSlotEquipment();
     void RemoveEquipment(int index, std::vector<std::wstring>& data);
 
     void UpdateIndex();
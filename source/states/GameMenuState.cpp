@@ -10,6 +10,7 @@
 #include "StateMachine.h"
 #include "IState.h"
 #include "../utility/Globals.h"
+#include "../Profiler.h"
 
 using namespace std::placeholders;
 
@@ -167,11 +168,7 @@ void GameMenuState::UpdatePlayerOrder()
             return rh->GetPartyPosition() < lh->GetPartyPosition();
         });
 
-    std::sort(m_PlayerSelector.GetData().begin(), m_PlayerSelector.GetData().end(),
-        [&](std::shared_ptr<Player>& rh, std::shared_ptr<Player>& lh)
-        {
-            return rh->GetPartyPosition() < lh->GetPartyPosition();
-        });
+    m_PlayerSelector.SetData(m_Party.GetParty());
 
     m_FirstChoice = m_SecondChoice = -1;
     m_bInMenuSelect = true;
@@ -216,6 +213,8 @@ GameMenuState::~GameMenuState()
 
 void GameMenuState::OnEnter()
 {
+    TRPG_PROFILE_SCOPE("GameMenuState::OnEnter");
+
     if (m_bInMenuSelect)
         m_PlayerSelector.HideCursor();
 
@@ -224,16 +223,22 @@ void GameMenuState::OnEnter()
 
 void GameMenuState::OnExit()
 {
+    TRPG_PROFILE_SCOPE("GameMenuState::OnExit");
+
     m_Console.ClearBuffer();
 }
 
 void GameMenuState::Update()
 {
+    TRPG_PROFILE_SCOPE("GameMenuState::Update");
+
     UpdatePlayerOrder();
 }
 
 void GameMenuState::Draw()
 {
+    TRPG_PROFILE_SCOPE("GameMenuState::Draw");
+
     DrawPanels();
     DrawPlayerInfo();
 
@@ -245,6 +250,8 @@ void GameMenuState::Draw()
 
 void GameMenuState::ProcessInputs()
 {
+    TRPG_PROFILE_SCOPE("GameMenuState::ProcessInputs");
+
     if (m_bInMenuSelect)
     {
         if (m_Keyboard.IsKeyJustPressed(KEY_BACKSPACE))
@@ -274,5 +281,7 @@ void GameMenuState::ProcessInputs()
 
 bool GameMenuState::Exit()
 {
+    TRPG_PROFILE_SCOPE("GameMenuState::Exit");
+
     return m_bExitGame;
 }
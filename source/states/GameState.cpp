@@ -6,14 +6,13 @@
 #include "../inputs/keyboard.h"
 #include "../Party.h"
 #include "../Potion.h"
-#include "../utility/ItemCreator.h"
+#include "../utility/ItemCatalog.h"
 #include "GameMenuState.h"
 #include "../Player.h"
-#include "../utility/ItemLoader.h"
-#include "../utility/Equipment.Loader.h"
 #include "../utility/ShopLoader.h" // Added missing include for ShopLoader
 #include <cassert>
 #include "../utility/ShopParameters.h"
+#include "../Profiler.h"
 
 GameState::GameState(Console& console, Keyboard& keyboard, StateMachine& stateMachine)
     : m_Console(console)
@@ -23,13 +22,37 @@ GameState::GameState(Console& console, Keyboard& keyboard, StateMachine& stateMa
     , m_TestInventory()
     , m_Party() // Initialize Party object
     , m_Timer()
-    , m_Typewriter{ console, 45, 15,
-        L"This is the new Typewriter\n"
-        L"The Typewriter will be used for different dialogs!"
-        L"Used for talking!", 60, 50, WHITE, BLUE
-    }
+    , m_DialogScript{ "./assets/dialogs/Dialogs.dlg" }
+    , m_Conversation{ m_DialogScript.GetText("typewriter_intro"), 60, 4 }
+    , m_Typewriter{ console, 45, 15, m_Conversation.GetPage(), 50, WHITE, BLUE }
 {
-    auto potion = ItemCreator::CreateItem(Item::ItemType::HEALTH, L"Potion", L"Heals a small amount of Health", 25, 50);
+    auto& catalog = ItemCatalog::GetInstance();
+
+    // Test items are defined here, a definition that is already loaded from file is used as it is
+    auto potion = catalog.CreateItem(catalog.AddItem({
+        .name = L"Potion", .description = L"Heals a small amount of Health",
+        .type = Item::ItemType::HEALTH, .value = 25, .buyPrice = 50, .sellPrice = 25
+    }));
+
+    auto create_weapon = [&](const wchar_t* name, const wchar_t* desc, int buy_price, WeaponProperties weapon, StatModifier modifier)
+    {
+        Equipment::Definition definition{
+            .name = name, .description = desc, .type = Equipment::EquipType::WEAPON,
+            .buyPrice = buy_price, .sellPrice = buy_price / 2, .statModifier = modifier
+        };
+        definition.properties.weapon = weapon;
+        return catalog.CreateEquipment(catalog.AddEquipment(std::move(definition)));
+    };
+
+    auto create_armour = [&](const wchar_t* name, const wchar_t* desc, int buy_price, ArmourProperties armour, StatModifier modifier)
+    {
+        Equipment::Definition definition{
+            .name = name, .description = desc, .type = Equipment::EquipType::ARMOUR,
+            .buyPrice = buy_price, .sellPrice = buy_price / 2, .statModifier = modifier
+        };
+        definition.properties.armour = armour;
+        return catalog.CreateEquipment(catalog.AddEquipment(std::move(definition)));
+    };
 
     // Initialize and add two players to the party
     auto player1 = std::make_shared<Player>(L"Player", L"test_player", m_TestInventory, 100, 200);
@@ -44,69 +67,29 @@ GameState::GameState(Console& console, Keyboard& keyboard, StateMachine& stateMa
     m_Party.GetInventory().AddItem(potion);
 
     // Equipment creation
-    auto sword1 = ItemCreator::CreateEquipment(
-        Equipment::EquipType::WEAPON,
-        WeaponProperties(15, WeaponProperties::WeaponType::SWORD),
-        ArmourProperties(),
-        StatModifier(3, StatModifier::ModifierType::STRENGTH),
-        L"Short Sword", L"A small sword, not very effective", 100
-    );
-
-    auto sword2 = ItemCreator::CreateEquipment(
-        Equipment::EquipType::WEAPON,
-        WeaponProperties(25, WeaponProperties::WeaponType::SWORD),
-        ArmourProperties(),
-        StatModifier(5, StatModifier::ModifierType::STRENGTH),
-        L"Long Sword", L"A long sword, more effective", 200
-    );
-
-    auto staff1 = ItemCreator::CreateEquipment(
-        Equipment::EquipType::WEAPON,
-        WeaponProperties(10, WeaponProperties::WeaponType::STAFF),
-        ArmourProperties(),
-        StatModifier(4, StatModifier::ModifierType::INTELLIGENCE),
-        L"Wooden Staff", L"A basic wooden staff", 80
-    );
-
-    auto staff2 = ItemCreator::CreateEquipment(
-        Equipment::EquipType::WEAPON,
-        WeaponProperties(20, WeaponProperties::WeaponType::STAFF),
-        ArmourProperties(),
-        StatModifier(8, StatModifier::ModifierType::INTELLIGENCE),
-        L"Enchanted Staff", L"A staff with magical properties", 160
-    );
-
-    auto chest1 = ItemCreator::CreateEquipment(
-        Equipment::EquipType::ARMOUR,
-        WeaponProperties(),
-        ArmourProperties(10, ArmourProperties::ArmourType::CHEST_BODY),
-        StatModifier(3, StatModifier::ModifierType::STRENGTH),
-        L"Leather Armour", L"A well-worn piece of armour", 100
-    );
-
-    auto chest2 = ItemCreator::CreateEquipment(
-        Equipment::EquipType::ARMOUR,
-        WeaponProperties(),
-        ArmourProperties(20, ArmourProperties::ArmourType::CHEST_BODY),
-        StatModifier(6, StatModifier::ModifierType::STRENGTH),
-        L"Steel Armour", L"A strong piece of armour", 200
-    );
-
-    auto helmet1 = ItemCreator::CreateEquipment(
-        Equipment::EquipType::ARMOUR,
-        WeaponProperties(),
-        ArmourProperties(5, ArmourProperties::ArmourType::HEADGEAR),
-        StatModifier(2, StatModifier::ModifierType::STRENGTH),
-        L"Iron Helmet", L"A sturdy iron helmet", 80
-    );
-
-    auto helmet2 = ItemCreator::CreateEquipment(
-        Equipment::EquipType::ARMOUR,
-        WeaponProperties(),
-        ArmourProperties(10, ArmourProperties::ArmourType::HEADGEAR),
-        StatModifier(4, StatModifier::ModifierType::STRENGTH),
-        L"Steel Helmet", L"A strong steel helmet", 160
-    );
+    auto sword1 = create_weapon(L"Short Sword", L"A small sword, not very effective", 100,
+        WeaponProperties(15, WeaponProperties::WeaponType::SWORD), StatModifier(3, StatModifier::ModifierType::STRENGTH));
+
+    auto sword2 = create_weapon(L"Long Sword", L"A long sword, more effective", 200,
+        WeaponProperties(25, WeaponProperties::WeaponType::SWORD), StatModifier(5, StatModifier::ModifierType::STRENGTH));
+
+    auto staff1 = create_weapon(L"Wooden Staff", L"A basic wooden staff", 80,
+        WeaponProperties(10, WeaponProperties::WeaponType::STAFF), StatModifier(4, StatModifier::ModifierType::INTELLIGENCE));
+
+    auto staff2 = create_weapon(L"Enchanted Staff", L"A staff with magical properties", 160,
+        WeaponProperties(20, WeaponProperties::WeaponType::STAFF), StatModifier(8, StatModifier::ModifierType::INTELLIGENCE));
+
+    auto chest1 = create_armour(L"Leather Armour", L"A well-worn piece of armour", 100,
+        ArmourProperties(10, ArmourProperties::ArmourType::CHEST_BODY), StatModifier(3, StatModifier::ModifierType::STRENGTH));
+
+    auto chest2 = create_armour(L"Steel Armour", L"A strong piece of armour", 200,
+        ArmourProperties(20, ArmourProperties::ArmourType::CHEST_BODY), StatModifier(6, StatModifier::ModifierType::STRENGTH));
+
+    auto helmet1 = create_armour(L"Iron Helmet", L"A sturdy iron helmet", 80,
+        ArmourProperties(5, ArmourProperties::ArmourType::HEADGEAR), StatModifier(2, StatModifier::ModifierType::STRENGTH));
+
+    auto helmet2 = create_armour(L"Steel Helmet", L"A strong steel helmet", 160,
+        ArmourProperties(10, ArmourProperties::ArmourType::HEADGEAR), StatModifier(4, StatModifier::ModifierType::STRENGTH));
 
     // Add equipment to players' inventories
     player1->GetInventory().AddEquipment(sword1);
@@ -125,34 +108,41 @@ GameState::~GameState()
 
 void GameState::OnEnter()
 {
+    TRPG_PROFILE_SCOPE("GameState::OnEnter");
+
     m_Console.ClearBuffer();
 
-    Logger::Log("Attempting to load 'Potion' from Weapons.xml...");
-    EquipmentLoader el{ "./assets/xml_files/WeaponsDefs.xml" };
-    auto equipment = el.CreateObjectFromFile("Potion");
+    Logger::Log("Looking up 'Potion' in the equipment catalog...");
+    auto equipment = ItemCatalog::GetInstance().FindEquipment(L"Potion");
 
     if (!equipment)
     {
-        Logger::Log("ERROR: Failed to load equipment item 'Potion' from Weapons.xml");
+        Logger::Log("ERROR: 'Potion' is not a piece of equipment");
     }
     else
     {
-        Logger::Log("Successfully loaded 'Potion' equipment from file.");
+        Logger::Log("Found 'Potion' in the equipment catalog.");
     }
 }
 
 void GameState::OnExit()
 {
+    TRPG_PROFILE_SCOPE("GameState::OnExit");
+
     m_Console.ClearBuffer();
 }
 
 void GameState::Update()
 {
+    TRPG_PROFILE_SCOPE("GameState::Update");
+
     m_Typewriter.UpdateText(); // Corrected to match the header file
 }
 
 void GameState::Draw()
 {
+    TRPG_PROFILE_SCOPE("GameState::Draw");
+
     std::wstring time_ms = L"MS: " + std::to_wstring(m_Timer.ElapsedMS());
     std::wstring time_sec = L"SEC:" + std::to_wstring(m_Timer.ElapsedSec());
 
@@ -168,12 +158,24 @@ void GameState::Draw()
 
 void GameState::ProcessInputs()
 {
+    TRPG_PROFILE_SCOPE("GameState::ProcessInputs");
+
     if (m_keyboard.IsKeyJustPressed(KEY_ESCAPE))
     {
         m_Statemachine.PopState();
         return;
     }
 
+    if (m_keyboard.IsKeyJustPressed(KEY_TAB))
+    {
+        if (!m_Typewriter.IsFinished())
+            m_Typewriter.Skip();
+        else if (m_Conversation.NextPage())
+            m_Typewriter.SetLayout(m_Conversation.GetPage());
+
+        return;
+    }
+
     if (m_keyboard.IsKeyJustPressed(KEY_M))
     {
         m_Statemachine.PushState(std::make_unique<GameMenuState>(m_Party, m_Console, m_Statemachine, m_keyboard));
@@ -209,5 +211,7 @@ void GameState::ProcessInputs()
 
 bool GameState::Exit()
 {
+    TRPG_PROFILE_SCOPE("GameState::Exit");
+
     return false;
 }
@@ -7,6 +7,7 @@
 #include <memory>
 #include "../utility/timer.h"
 #include "../utility/TypeWriter.h"
+#include "../utility/DialogScript.h"
 
 class Console;
 class Keyboard;
@@ -25,6 +26,8 @@ private:
     Party m_Party; 
     Timer m_Timer;
 
+    DialogScript m_DialogScript;
+    Conversation m_Conversation;
     Typewriter m_Typewriter;
 public:
     GameState(Console& m_Console, Keyboard& keyboard, StateMachine& statemachine);
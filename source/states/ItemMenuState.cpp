@@ -4,6 +4,8 @@
 #include "StateMachine.h"
 #include "../Inputs/Keyboard.h"
 #include "../utility/trpg_utilities.h"
+#include "../utility/TextLayout.h"
+#include "../Profiler.h"
 
 using namespace std::placeholders;
 
@@ -98,8 +100,8 @@ void ItemState::OnItemSelect(int index, std::vector<std::shared_ptr<Item>> data)
     const auto item_count = data[index]->GetCount();
     if (item_count <= 0)
     {
-        remove(data, index);
-        m_ItemSelector.SetData(items.GetItems());
+        // The selector is bound to the inventory, which already removed the item
+        m_ItemSelector.Refresh();
 
         // Clear the buffer
         m_Console.ClearBuffer();
@@ -116,16 +118,21 @@ void ItemState::RenderItem(int x, int y, std::shared_ptr<Item> item)
     m_Console.Write(x, y, item_name);
     m_Console.Write(x + static_cast<int>(item_name.size() + 1), y, std::to_wstring(item->GetCount()));
 
-    if (index < data.size())
-    {
-        const std::wstring& item_desc = item->GetDescription();
-        m_Console.Write(m_CenterScreenW - static_cast<int>(item_desc.size() / 2), 12, item_desc, LIGHT_BLUE);
-    }
+    if (index >= data.size() || data[index] != item)
+        return;
+
+    // Only the selected item shows its description, on the single row between the panel bars
+    const auto layout = TextLayoutCache::GetInstance().Get(data[index]->GetDescription(), PANEL_BARS - 2);
+    const auto item_desc = layout->GetLine(0);
+
+    m_Console.DrawPanelHorz(m_PanelBarX, 12, PANEL_BARS - 1, LIGHT_BLUE, L" ");
+    m_Console.Write(m_CenterScreenW - static_cast<int>(item_desc.size() / 2), 12, item_desc, LIGHT_BLUE);
 }
 
 void ItemState::FocusOnMenu()
 {
     m_bInMenuSelect = true;
+    m_ItemSelector.StopSearch();
     SelectorFunc(m_MenuSelector.GetIndex(), SelectType::HIDE);
     m_MenuSelector.ShowCursor();
 }
@@ -149,7 +156,9 @@ ItemState::ItemState(Player& player, Console& console, StateMachine& statMachine
     , m_PanelBarX{ m_CenterScreenW - (PANEL_BARS / 2) }
 {
     m_MenuSelector.SetSelectionFunc(std::bind(&ItemState::OnMenuSelect, this, _1, _2));
-    m_ItemSelector.SetData(m_Player.GetInventory().GetItems());
+    const auto& inventory = m_Player.GetInventory();
+    m_ItemSelector.BindData(inventory.GetItems(), inventory.GetItemView(InventorySort::NAME).GetOrder());
+    m_ItemSelector.EnableSearch([](const std::shared_ptr<Item>& item) -> const std::wstring& { return item->GetItemName(); }, 30, m_ScreenHeight - 11);
 }
 
 ItemState::~ItemState()
@@ -158,22 +167,29 @@ ItemState::~ItemState()
 
 void ItemState::OnEnter()
 {
-    TRPG_LOG("Entered Item State")
+    TRPG_PROFILE_SCOPE("ItemState::OnEnter");
+
+    TRPG_LOG("Entered Item State");
     m_Console.ClearBuffer();
 }
 
 void ItemState::OnExit()
 {
-    TRPG_LOG("Exited Item State")
+    TRPG_PROFILE_SCOPE("ItemState::OnExit");
+
+    TRPG_LOG("Exited Item State");
     m_Console.ClearBuffer();
 }
 
 void ItemState::Update()
 {
+    TRPG_PROFILE_SCOPE("ItemState::Update");
 }
 
 void ItemState::Draw()
 {
+    TRPG_PROFILE_SCOPE("ItemState::Draw");
+
     m_Console.Draw();
     DrawInventory();
     DrawPlayerInfo();
@@ -186,6 +202,8 @@ void ItemState::Draw()
 
 void ItemState::ProcessInputs()
 {
+    TRPG_PROFILE_SCOPE("ItemState::ProcessInputs");
+
     if (m_bInMenuSelect)
     {
         m_MenuSelector.ProcessInputs();
@@ -196,13 +214,16 @@ void ItemState::ProcessInputs()
     }
     else
     {
-        if (m_Keyboard.IsKeyJustPressed(KEY_BACKSPACE))
+        // Typed keys belong to the item search while it is open
+        const bool searching = m_ItemSelector.IsSearching();
+
+        if (!searching && m_Keyboard.IsKeyJustPressed(KEY_BACKSPACE))
         {
             FocusOnMenu();
             m_Console.ClearBuffer();
         }
 
-        if (m_Keyboard.IsKeyJustPressed(KEY_P)) // Use 'P' to use a potion
+        if (!searching && m_Keyboard.IsKeyJustPressed(KEY_P)) // Use 'P' to use a potion
         {
             int selectedIndex = m_ItemSelector.GetIndex();
             auto& items = m_Player.GetInventory().GetItems();
@@ -218,5 +239,7 @@ void ItemState::ProcessInputs()
 
 bool ItemState::Exit()
 {
+    TRPG_PROFILE_SCOPE("ItemState::Exit");
+
     return false;
 }
@@ -9,8 +9,9 @@
 
 #include "../utility/ShopLoader.h"
 #include "../utility/ShopParameters.h"
-#include "../utility/ItemCreator.h"
+#include "../utility/TextLayout.h"
 #include "../Logger.h"
+#include "../Profiler.h"
 
 using namespace std::placeholders;
 
@@ -33,6 +34,8 @@ ShopState::ShopState(Party& party, Console& console, StateMachine& stateMachine,
     , m_bIsEquipmentShop{ false }, m_bBuySellItem{ false }, m_bExitShop{ false }
     , m_AvailableSellQuantity{ 0 } // Fix for uninitialized variable
     , m_PanelBarX{ 0 }             // Fix for uninitialized variable
+    , m_LastResult{ Transaction::Result::OK }
+    , m_pListedInventory{ nullptr }, m_ListedVersion{ 0 }
 {
     ShopLoader shopLoader{};
     m_pShopParameters = std::move(shopLoader.CreateShopParametersFromFile(shopFilepath));
@@ -49,12 +52,10 @@ ShopState::ShopState(Party& party, Console& console, StateMachine& stateMachine,
     case ShopParameters::ShopType::WEAPON:
     case ShopParameters::ShopType::ARMOUR:
     case ShopParameters::ShopType::RELIC:
-        m_EquipmentSelector.SetData(m_pShopParameters->inventory->GetEquipment());
         m_bIsEquipmentShop = true;
         break;
     case ShopParameters::ShopType::ITEM:
     {
-        m_ItemSelector.SetData(m_pShopParameters->inventory->GetItems());
         m_bIsEquipmentShop = false;
 
         // Debug log to verify items
@@ -79,6 +80,9 @@ ShopState::ShopState(Party& party, Console& console, StateMachine& stateMachine,
         break;
     }
 
+    m_EquipmentSelector.EnableSearch([](const std::shared_ptr<Equipment>& equipment) -> const std::wstring& { return equipment->GetName(); }, 30, 17);
+    m_ItemSelector.EnableSearch([](const std::shared_ptr<Item>& item) -> const std::wstring& { return item->GetItemName(); }, 30, 17);
+
     m_ShopChoiceSelector.SetSelectionFunc(std::bind(&ShopState::OnShopMenuSelect, this, _1, _2));
     m_BuySellSelector.SetSelectionFunc(std::bind(&ShopState::BuySellOptions, this, _1, _2));
     m_BuySellSelector.HideCursor();
@@ -91,16 +95,22 @@ ShopState::~ShopState()
 
 void ShopState::OnEnter()
 {
+    TRPG_PROFILE_SCOPE("ShopState::OnEnter");
+
     m_Console.ClearBuffer();
 }
 
 void ShopState::OnExit()
 {
+    TRPG_PROFILE_SCOPE("ShopState::OnExit");
+
     m_Console.ClearBuffer();
 }
 
 void ShopState::Update()
 {
+    TRPG_PROFILE_SCOPE("ShopState::Update");
+
     if (m_bExitShop)
     {
         m_StateMachine.PopState();
@@ -118,6 +128,8 @@ void ShopState::Update()
 
 void ShopState::Draw()
 {
+    TRPG_PROFILE_SCOPE("ShopState::Draw");
+
     DrawShop();
     m_ShopChoiceSelector.Draw();
 
@@ -137,36 +149,31 @@ void ShopState::Draw()
         m_BuySellSelector.Draw();
     }
 
+    if (m_LastResult != Transaction::Result::OK)
+        m_Console.Write(80, 34, Transaction::GetMessage(m_LastResult), RED);
+
     m_Console.Draw();
 }
 
 void ShopState::ProcessInputs()
 {
+    TRPG_PROFILE_SCOPE("ShopState::ProcessInputs");
+
     if (m_bInShopSelect)
     {
         m_ShopChoiceSelector.ProcessInputs();
         return;
     }
 
-    if (m_bInItemBuy && !m_bBuySellItem)
+    if ((m_bInItemBuy || m_bInItemSell) && !m_bSetFuncs)
     {
-        if (!m_bSetFuncs)
-        {
-            m_EquipmentSelector.SetSelectionFunc(std::bind(&ShopState::OnSellEquipmentSelect, this, _1, _2));
-            m_EquipmentSelector.SetDrawFunc(std::bind(&ShopState::RenderSellEquipment, this, _1, _2, _3));
-            m_EquipmentSelector.SetData(m_Party.GetInventory().GetEquipment());
-        }
-        else
-        {
-            m_ItemSelector.SetSelectionFunc(std::bind(&ShopState::OnSellItemSelect, this, _1, _2));
-            m_ItemSelector.SetDrawFunc(std::bind(&ShopState::RenderSellItems, this, _1, _2, _3));
-            m_ItemSelector.SetData(m_Party.GetInventory().GetItems());
-        }
-
+        SetSelectorFuncs();
         m_bSetFuncs = true;
     }
 
-    if (m_Keyboard.IsKeyJustPressed(KEY_BACKSPACE))
+    const bool searching = m_EquipmentSelector.IsSearching() || m_ItemSelector.IsSearching();
+
+    if (!searching && m_Keyboard.IsKeyJustPressed(KEY_BACKSPACE))
     {
         ResetSelections();
         return;
@@ -287,68 +294,138 @@ void ShopState::DrawItemsBox()
     // Draw gold display
     const auto& goldStr = std::to_wstring(m_Party.GetGold());
     m_Console.Write(boxX + 60, boxY + 1, L"GOLD: " + goldStr, WHITE);
+
+    DrawDescription(boxX + 2, boxY + 21);
+}
+
+void ShopState::DrawDescription(int x, int y)
+{
+    const int width = 46;
+    const size_t max_lines = 4;
+
+    const std::wstring* description = nullptr;
+
+    if (m_bIsEquipmentShop)
+    {
+        const auto& data = m_EquipmentSelector.GetData();
+        const size_t index = m_EquipmentSelector.GetIndex();
+        if (index < data.size())
+            description = &data[index]->GetDescription();
+    }
+    else
+    {
+        const auto& data = m_ItemSelector.GetData();
+        const size_t index = m_ItemSelector.GetIndex();
+        if (index < data.size())
+            description = &data[index]->GetDescription();
+    }
+
+    // Clear the previous description, it can have more lines than the new one
+    for (size_t i = 0; i < max_lines; i++)
+        m_Console.DrawPanelHorz(x, y + static_cast<int>(i), width, LIGHT_BLUE, L" ");
+
+    if (!description)
+        return;
+
+    const auto layout = TextLayoutCache::GetInstance().Get(*description, width);
+
+    for (size_t i = 0; i < layout->GetNumLines() && i < max_lines; i++)
+        m_Console.Write(x, y + static_cast<int>(i), layout->GetLine(i), LIGHT_BLUE);
+}
+
+void ShopState::SetSelectorFuncs()
+{
+    // Buying lists the shop stock by price, selling lists the party inventory by name
+    const auto& inventory = m_bInItemBuy ? *m_pShopParameters->inventory : m_Party.GetInventory();
+    const auto sort = m_bInItemBuy ? InventorySort::PRICE : InventorySort::NAME;
+
+    // Going back to the same list after nothing changed keeps the selector as it was
+    const uint64_t version = m_bIsEquipmentShop ? inventory.GetEquipmentVersion() : inventory.GetItemVersion();
+    const bool rebind = &inventory != m_pListedInventory || version != m_ListedVersion;
+    m_pListedInventory = &inventory;
+    m_ListedVersion = version;
+
+    if (m_bIsEquipmentShop)
+    {
+        if (m_bInItemBuy)
+        {
+            m_EquipmentSelector.SetSelectionFunc(std::bind(&ShopState::OnBuyEquipmentSelect, this, _1, _2));
+            m_EquipmentSelector.SetDrawFunc(std::bind(&ShopState::RenderBuyEquipment, this, _1, _2, _3));
+        }
+        else
+        {
+            m_EquipmentSelector.SetSelectionFunc(std::bind(&ShopState::OnSellEquipmentSelect, this, _1, _2));
+            m_EquipmentSelector.SetDrawFunc(std::bind(&ShopState::RenderSellEquipment, this, _1, _2, _3));
+        }
+
+        if (rebind)
+            m_EquipmentSelector.BindData(inventory.GetEquipment(), inventory.GetEquipmentView(sort).GetOrder());
+    }
+    else
+    {
+        if (m_bInItemBuy)
+        {
+            m_ItemSelector.SetSelectionFunc(std::bind(&ShopState::OnBuyItemSelect, this, _1, _2));
+            m_ItemSelector.SetDrawFunc(std::bind(&ShopState::RenderBuyItems, this, _1, _2, _3));
+        }
+        else
+        {
+            m_ItemSelector.SetSelectionFunc(std::bind(&ShopState::OnSellItemSelect, this, _1, _2));
+            m_ItemSelector.SetDrawFunc(std::bind(&ShopState::RenderSellItems, this, _1, _2, _3));
+        }
+
+        if (rebind)
+            m_ItemSelector.BindData(inventory.GetItems(), inventory.GetItemView(sort).GetOrder());
+    }
 }
 
 void ShopState::ResetSelections()
 {
+	m_LastResult = Transaction::Result::OK;
 	m_bInItemBuy = false;
 	m_bInItemSell = false;
 	m_bSetFuncs = false;
 	m_bBuySellItem = false;
 	m_bInShopSelect = true;
 
+	m_ItemSelector.StopSearch();
+	m_EquipmentSelector.StopSearch();
 	m_ItemSelector.HideCursor();
 	m_EquipmentSelector.HideCursor();
 	m_ShopChoiceSelector.ShowCursor();
 	m_Console.ClearBuffer();
 }
 
+void ShopState::ClearLastResult()
+{
+    if (m_LastResult == Transaction::Result::OK)
+        return;
+
+    // The message stays in the console buffer until it is cleared
+    m_LastResult = Transaction::Result::OK;
+    m_Console.ClearBuffer();
+}
+
 void ShopState::BuyEquipment()
 {
     int itemIndex = m_EquipmentSelector.GetIndex();
     const auto& item = m_EquipmentSelector.GetData()[itemIndex];
 
-    if (item->GetCount() + m_Quantity - 1 > item->GetMaxCount())
-        return;
-
-    auto newItem = ItemCreator::CreateEquipment(
-        item->GetType(),
-        item->GetWeaponProperties(),
-        item->GetArmourProperties(),
-        item->GetStatModifier(),
-        item->GetName(),
-        item->GetDescription(),
-        item->GetBuyPrice(),
-        item->GetSellPrice() // Added missing argument
-    );
-    assert(newItem, &"Failed to create new item!");
-    
-    newItem->Add(m_Quantity - 1);
-
-    auto& Inventory = m_Party.GetInventory();
-
-    for (const auto& it : Inventory.GetEquipment())
-    {
-        if (newItem->GetName() != it->GetName())
-            continue;
+    Transaction cart;
+    cart.AddEquipment(item->GetDefinition(), m_Quantity);
 
-        if (newItem->GetCount() + it->GetCount() > it->GetMaxCount())
-        {
-            return;
-        }
-        break;
-    }
-
-    if (!m_Party.BuyEquipment(m_Quantity * m_Price, std::move(newItem)))
-    {
-        m_Console.Write(80, 34, L"Failed to buy the Equipment!", RED);
-        return;
-    }
+    m_LastResult = m_Party.Buy(cart);
 }
 
-
 void ShopState::SellEquipment()
 {
+    int itemIndex = m_EquipmentSelector.GetIndex();
+    const auto& item = m_EquipmentSelector.GetData()[itemIndex];
+
+    Transaction cart;
+    cart.AddEquipment(item->GetDefinition(), m_Quantity);
+
+    m_LastResult = m_Party.Sell(cart);
 }
 
 void ShopState::BuyItems()
@@ -356,44 +433,21 @@ void ShopState::BuyItems()
     int itemIndex = m_ItemSelector.GetIndex();
     const auto& item = m_ItemSelector.GetData()[itemIndex];
 
-    if (item->GetCount() + m_Quantity - 1 > item->GetMaxCount())
-        return;
-
-    auto newItem = ItemCreator::CreateItem(
-        item->GetType(),
-        item->GetItemName(),
-        item->GetDescription(),
-        item->GetItemValue(),
-        item->GetBuyPrice()
-    );
-    assert(newItem, &"Failed to create new item!");
-
-    newItem->AddItem(m_Quantity - 1);
-
-    auto& Inventory = m_Party.GetInventory();
-
-    for (const auto& it : Inventory.GetItems())
-    {
-        if (newItem->GetItemName() != it->GetItemName())
-            continue;
-
-        if (newItem->GetCount() + it->GetCount() > it->GetMaxCount())
-        {
-            return;
-        }
-        break;
-    }
+    Transaction cart;
+    cart.AddItem(item->GetDefinition(), m_Quantity);
 
-    if (!m_Party.BuyItem(m_Quantity * m_Price, std::move(newItem)))
-    {
-        m_Console.Write(80, 34, L"Failed to buy the Item!", RED);
-        return;
-    }
+    m_LastResult = m_Party.Buy(cart);
 }
 
 void ShopState::SellItems()
 {
+    int itemIndex = m_ItemSelector.GetIndex();
+    const auto& item = m_ItemSelector.GetData()[itemIndex];
+
+    Transaction cart;
+    cart.AddItem(item->GetDefinition(), m_Quantity);
 
+    m_LastResult = m_Party.Sell(cart);
 }
 
 void ShopState::OnShopMenuSelect(int index, std::vector<std::wstring> data)
@@ -454,6 +508,10 @@ void ShopState::BuySellOptions(int index, std::vector<std::wstring> data)
 			SellItems();
 	}
 
+	// The lists are bound to the inventories, pick up any new or removed entries
+	m_EquipmentSelector.Refresh();
+	m_ItemSelector.Refresh();
+
     m_bBuySellItem = false;
     m_BuySellSelector.HideCursor();
     m_Quantity = 0;
@@ -465,6 +523,8 @@ void ShopState::BuySellOptions(int index, std::vector<std::wstring> data)
 
 void ShopState::OnBuyItemSelect(int index, std::vector<std::shared_ptr<Item>> data)
 {
+	ClearLastResult();
+
 	const auto& item = data[index];
 	const auto& price = item->GetBuyPrice();
 	m_bBuySellItem = true;
@@ -474,6 +534,8 @@ void ShopState::OnBuyItemSelect(int index, std::vector<std::shared_ptr<Item>> da
 
 void ShopState::OnBuyEquipmentSelect(int index, std::vector<std::shared_ptr<Equipment>> data)
 {
+	ClearLastResult();
+
 	const auto& item = data[index];
 	const auto& price = item->GetBuyPrice();
 	m_bBuySellItem = true;
@@ -483,6 +545,8 @@ void ShopState::OnBuyEquipmentSelect(int index, std::vector<std::shared_ptr<Equi
 
 void ShopState::OnSellItemSelect(int index, std::vector<std::shared_ptr<Item>> data)
 {
+	ClearLastResult();
+
 	const auto& item = data[index];
 	const auto& price = item->GetSellPrice();
 	m_bBuySellItem = true;
@@ -493,12 +557,15 @@ void ShopState::OnSellItemSelect(int index, std::vector<std::shared_ptr<Item>> d
 
 void ShopState::OnSellEquipmentSelect(int index, std::vector<std::shared_ptr<Equipment>> data)
 {
+    ClearLastResult();
+
     const auto& item = data[index];
     const auto& price = item->GetSellPrice();
     m_bBuySellItem = true;
     m_BuySellSelector.ShowCursor();
     m_Price = price;
-    m_AvailableSellQuantity = item->GetCount();
+    // The equipped copy can not be sold, the same as Inventory::CanRemove
+    m_AvailableSellQuantity = item->GetCount() - (item->IsEquipped() ? 1 : 0);
 }
 
 void ShopState::RenderBuyItems(int x, int y, std::shared_ptr<Item> item)
@@ -1,12 +1,14 @@
 #pragma once
 #include "IState.h"
 #include "../Selector.h"
+#include "../Transaction.h"
 
 class Party;
 class Console;
 class StateMachine;
 class Keyboard;
 struct ShopParameters;
+class Inventory;
 class Item;
 class Equipment;
 
@@ -31,11 +33,20 @@ private:
     bool m_bInShopSelect, m_bInItemBuy, m_bInItemSell;
     bool m_bIsEquipmentShop, m_bExitShop, m_bBuySellItem;
     bool m_bSetFuncs;
+    // Why the last buy or sell failed, drawn until the next one is started
+    Transaction::Result m_LastResult;
+
+    // The inventory the list selector shows and its version at the time, it is only bound again after a change
+    const Inventory* m_pListedInventory;
+    uint64_t m_ListedVersion;
 
     void DrawShop();
     void DrawBuyItems();
     void DrawItemsBox();
+    void DrawDescription(int x, int y);
+    void SetSelectorFuncs();
     void ResetSelections();
+    void ClearLastResult();
 
     void BuyEquipment();
     void SellEquipment();
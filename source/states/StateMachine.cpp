@@ -1,4 +1,10 @@
 #include "StateMachine.h"
+#include "../utility/Metrics.h"
+
+namespace
+{
+	Metric g_StateDepth{ "State depth", MetricKind::GAUGE };
+}
 
 StateMachine::StateMachine()
 	: m_States()
@@ -12,6 +18,8 @@ StateMachine::~StateMachine()
 void StateMachine::PushState(StatePtr newState)
 {
 	m_States.push(std::move(newState));
+	g_StateDepth.Set(static_cast<int64_t>(m_States.size()));
+
 	m_States.top()->OnEnter();
 }
 
@@ -23,6 +31,7 @@ StatePtr StateMachine::PopState()
 	auto oldState = std::move(m_States.top());
 
 	m_States.pop();
+	g_StateDepth.Set(static_cast<int64_t>(m_States.size()));
 
 	oldState->OnExit();
 
@@ -17,5 +17,6 @@ public:
     void PushState(StatePtr newState);
     StatePtr PopState();
     const bool Empty() const { return m_States.empty(); }
+    const size_t Size() const { return m_States.size(); }
     StatePtr& GetCurrentState();
 };
@@ -4,6 +4,7 @@
 #include "../Inputs/Keyboard.h"
 #include "StateMachine.h"
 #include <cassert>
+#include "../Profiler.h"
 
 void StatusMenuState::DrawStatusPanel()
 {
@@ -73,8 +74,10 @@ void StatusMenuState::DrawPlayerInfo()
 
     int equipment_lines = 0;
     const auto& equipment = m_Player.GetEquippedItemSlots();
-    for (const auto& [slot, item] : equipment)
+    for (size_t i = 0; i < Stats::NUM_EQUIP_SLOTS; i++)
     {
+        const Stats::EquipSlots slot = static_cast<Stats::EquipSlots>(i);
+        const auto& item = equipment[slot];
         m_Console.Write(STAT_LABEL_X_POS, 21 + equipment_lines, slot2str(slot));
         m_Console.Write(STAT_VAL_X_POS, 21 + equipment_lines, item ? item->GetName() : L"Empty");
         ++equipment_lines;
@@ -87,13 +90,12 @@ void StatusMenuState::DrawPlayerInfo()
     m_Console.Write(STAT_LABEL_X_POS, attr_start_y - 2, L"ATTRIBUTES", BLUE);
     m_Console.Write(STAT_LABEL_X_POS, attr_start_y - 1, L"=========", BLUE);
 
-    const auto& stat_list = m_Player.GetStats().GetStatList();
-    for (const auto& [stat, value] : stat_list)
+    const auto& stats = m_Player.GetStats();
+    for (size_t i = 0; i < NUM_STATS; i++)
     {
-        int mod = m_Player.GetStats().GetModifier(stat);
-        std::wstring value_str = std::to_wstring(value + mod);
-        m_Console.Write(STAT_LABEL_X_POS, attr_start_y + attr_index, stat);
-        m_Console.Write(STAT_VAL_X_POS, attr_start_y + attr_index, value_str);
+        const StatId stat = static_cast<StatId>(i);
+        m_Console.Write(STAT_LABEL_X_POS, attr_start_y + attr_index, GetStatName(stat));
+        m_Console.Write(STAT_VAL_X_POS, attr_start_y + attr_index, std::to_wstring(stats.GetTotal(stat)));
         ++attr_index;
     }
 }
@@ -114,20 +116,27 @@ StatusMenuState::~StatusMenuState()
 
 void StatusMenuState::OnEnter()
 {
+    TRPG_PROFILE_SCOPE("StatusMenuState::OnEnter");
+
     m_Console.ClearBuffer();
 }
 
 void StatusMenuState::OnExit()
 {
+    TRPG_PROFILE_SCOPE("StatusMenuState::OnExit");
+
     m_Console.ClearBuffer();
 }
 
 void StatusMenuState::Update()
 {
+    TRPG_PROFILE_SCOPE("StatusMenuState::Update");
 }
 
 void StatusMenuState::Draw()
 {
+    TRPG_PROFILE_SCOPE("StatusMenuState::Draw");
+
     DrawStatusPanel();
     DrawPlayerInfo();
 
@@ -136,6 +145,8 @@ void StatusMenuState::Draw()
 
 void StatusMenuState::ProcessInputs()
 {
+	TRPG_PROFILE_SCOPE("StatusMenuState::ProcessInputs");
+
 	if (m_Keyboard.IsKeyJustPressed(KEY_BACKSPACE))
 	{
 		m_StateMachine.PopState();
@@ -144,5 +155,7 @@ void StatusMenuState::ProcessInputs()
 
 bool StatusMenuState::Exit()
 {
+	TRPG_PROFILE_SCOPE("StatusMenuState::Exit");
+
 	return false;
 }
@@ -0,0 +1,69 @@
+#include "AllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+/*
+* Replaces the global operator new and delete to count allocations for the performance overlay.
+* The count is a plain atomic rather than a registered metric, because operator new can run before the
+* registry's static is constructed, or while it is being constructed.
+*/
+namespace
+{
+    std::atomic<uint64_t> g_AllocationCount{ 0 };
+
+    void* Allocate(std::size_t size)
+    {
+        g_AllocationCount.fetch_add(1, std::memory_order_relaxed);
+
+        if (size == 0)
+            size = 1;
+
+        while (true)
+        {
+            if (void* memory = std::malloc(size))
+                return memory;
+
+            std::new_handler handler = std::get_new_handler();
+            if (!handler)
+                throw std::bad_alloc{};
+
+            handler();
+        }
+    }
+}
+
+const uint64_t GetAllocationCount()
+{
+    return g_AllocationCount.load(std::memory_order_relaxed);
+}
+
+void* operator new(std::size_t size)
+{
+    return Allocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return Allocate(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
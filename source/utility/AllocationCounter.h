@@ -0,0 +1,6 @@
+#pragma once
+
+#include <cstdint>
+
+// Number of calls to the global operator new since the program started
+const uint64_t GetAllocationCount();
@@ -0,0 +1,48 @@
+#include "Clock.h"
+
+using namespace std::chrono;
+
+std::unique_ptr<Clock> Clock::m_pInstance = nullptr;
+
+Clock::Clock()
+    : m_StartPoint{ steady_clock::now() }, m_LastPoint{ m_StartPoint }
+    , m_RealMS{ 0 }, m_RealDeltaMS{ 0 }, m_GameDeltaMS{ 0 }, m_FrameTimeUS{ 0 }
+    , m_GameMS{ 0.0 }, m_TimeScale{ 1.0 }, m_bPaused{ false }
+{
+}
+
+Clock& Clock::GetInstance()
+{
+    if (!m_pInstance)
+        m_pInstance.reset(new Clock());
+
+    return *m_pInstance;
+}
+
+void Clock::Tick()
+{
+    const auto now = steady_clock::now();
+
+    const int64_t real_ms = duration_cast<milliseconds>(now - m_StartPoint).count();
+    m_RealDeltaMS = real_ms - m_RealMS;
+    m_RealMS = real_ms;
+
+    // Game time keeps the fraction of a millisecond, so small time scales still move it forward
+    const int64_t game_ms = static_cast<int64_t>(m_GameMS);
+    if (!m_bPaused)
+        m_GameMS += duration<double, std::milli>(now - m_LastPoint).count() * m_TimeScale;
+
+    m_GameDeltaMS = static_cast<int64_t>(m_GameMS) - game_ms;
+    m_FrameTimeUS = duration_cast<microseconds>(now - m_LastPoint).count();
+    m_LastPoint = now;
+}
+
+const int64_t Clock::Now(TimeDomain domain) const
+{
+    return domain == TimeDomain::GAME ? static_cast<int64_t>(m_GameMS) : m_RealMS;
+}
+
+const int64_t Clock::GetDeltaMS(TimeDomain domain) const
+{
+    return domain == TimeDomain::GAME ? m_GameDeltaMS : m_RealDeltaMS;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <cstdint>
+
+enum class TimeDomain { REAL = 0, GAME };
+
+/*
+* Time sampled once per tick, so everything in a frame sees the same time without asking the OS again.
+* REAL time always runs, GAME time is scaled by the time scale and stops while paused.
+*/
+class Clock
+{
+private:
+    std::chrono::time_point<std::chrono::steady_clock> m_StartPoint, m_LastPoint;
+    int64_t m_RealMS, m_RealDeltaMS, m_GameDeltaMS, m_FrameTimeUS;
+    double m_GameMS, m_TimeScale;
+    bool m_bPaused;
+
+    Clock();
+
+    static std::unique_ptr<Clock> m_pInstance;
+public:
+    static Clock& GetInstance();
+
+    // Samples the time, called once at the start of every tick
+    void Tick();
+
+    // Milliseconds since the clock was created, as of the last tick
+    const int64_t Now(TimeDomain domain = TimeDomain::REAL) const;
+    const int64_t GetDeltaMS(TimeDomain domain = TimeDomain::REAL) const;
+    // Real time between the last two ticks, in microseconds
+    inline const int64_t GetFrameTimeUS() const { return m_FrameTimeUS; }
+
+    inline void SetTimeScale(double scale) { m_TimeScale = scale < 0.0 ? 0.0 : scale; }
+    inline const double GetTimeScale() const { return m_TimeScale; }
+
+    inline void Pause() { m_bPaused = true; }
+    inline void Resume() { m_bPaused = false; }
+    inline const bool IsPaused() const { return m_bPaused; }
+};
@@ -0,0 +1,213 @@
+#include "DialogScript.h"
+#include "../Logger.h"
+#include <algorithm>
+
+bool DialogScript::Map(const std::string& filepath)
+{
+    m_hFile = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+    if (m_hFile == INVALID_HANDLE_VALUE)
+    {
+        TRPG_LOG_CAT(LogLevel::ERR, LogCategory::LOADER, "Failed to open dialog script [" + filepath + "]");
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(m_hFile, &size))
+    {
+        TRPG_LOG_CAT(LogLevel::ERR, LogCategory::LOADER, "Failed to get the size of dialog script [" + filepath + "]");
+        return false;
+    }
+
+    // An empty file cannot be mapped, it simply has no dialogs
+    if (size.QuadPart == 0)
+        return true;
+
+    m_hMapping = CreateFileMappingA(m_hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+
+    if (!m_hMapping)
+    {
+        TRPG_LOG_CAT(LogLevel::ERR, LogCategory::LOADER, "Failed to map dialog script [" + filepath + "]");
+        return false;
+    }
+
+    m_pData = static_cast<const char*>(MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0));
+
+    if (!m_pData)
+    {
+        TRPG_LOG_CAT(LogLevel::ERR, LogCategory::LOADER, "Failed to map a view of dialog script [" + filepath + "]");
+        return false;
+    }
+
+    m_Size = static_cast<size_t>(size.QuadPart);
+    return true;
+}
+
+void DialogScript::Unmap()
+{
+    if (m_pData)
+        UnmapViewOfFile(m_pData);
+
+    if (m_hMapping)
+        CloseHandle(m_hMapping);
+
+    if (m_hFile != INVALID_HANDLE_VALUE)
+        CloseHandle(m_hFile);
+
+    m_pData = nullptr;
+    m_hMapping = NULL;
+    m_hFile = INVALID_HANDLE_VALUE;
+    m_Size = 0;
+    m_Index.clear();
+}
+
+void DialogScript::BuildIndex()
+{
+    std::string_view data{ m_pData, m_Size };
+
+    // Skip the UTF-8 byte order mark
+    if (data.substr(0, 3) == "\xEF\xBB\xBF")
+        data.remove_prefix(3);
+
+    std::string_view id{};
+    size_t body_start = 0;
+    size_t pos = 0;
+
+    auto end_dialog = [&](size_t body_end) {
+        if (id.empty())
+            return;
+
+        if (!m_Index.emplace(id, data.substr(body_start, body_end - body_start)).second)
+            TRPG_LOG_CAT(LogLevel::ERR, LogCategory::LOADER, "Dialog [" + std::string{ id } + "] is defined more than once");
+        };
+
+    while (pos < data.size())
+    {
+        size_t line_end = data.find('\n', pos);
+        if (line_end == std::string_view::npos)
+            line_end = data.size();
+
+        if (data[pos] == '@')
+        {
+            end_dialog(pos);
+
+            id = data.substr(pos + 1, line_end - pos - 1);
+            while (!id.empty() && (id.back() == '\r' || id.back() == ' ' || id.back() == '\t'))
+                id.remove_suffix(1);
+
+            body_start = std::min(line_end + 1, data.size());
+        }
+
+        pos = line_end + 1;
+    }
+
+    end_dialog(data.size());
+}
+
+DialogScript::DialogScript(const std::string& filepath)
+    : m_hFile{ INVALID_HANDLE_VALUE }, m_hMapping{ NULL }, m_pData{ nullptr }, m_Size{ 0 }, m_Index{}
+{
+    if (!Map(filepath))
+    {
+        Unmap();
+        return;
+    }
+
+    if (m_pData)
+        BuildIndex();
+
+    TRPG_LOGF(LogLevel::INFO, LogCategory::LOADER, "Indexed {} dialogs from [{}]", m_Index.size(), filepath);
+}
+
+DialogScript::~DialogScript()
+{
+    Unmap();
+}
+
+std::wstring DialogScript::GetText(std::string_view id) const
+{
+    auto it = m_Index.find(id);
+    if (it == m_Index.end())
+    {
+        TRPG_LOG_CAT(LogLevel::ERR, LogCategory::LOADER, "Dialog [" + std::string{ id } + "] does not exist");
+        return std::wstring{};
+    }
+
+    const std::string_view body = it->second;
+    std::string text;
+    text.reserve(body.size());
+
+    size_t pos = 0;
+    while (pos < body.size())
+    {
+        size_t line_end = body.find('\n', pos);
+        if (line_end == std::string_view::npos)
+            line_end = body.size();
+
+        std::string_view line = body.substr(pos, line_end - pos);
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+
+        if (line.empty() || line[0] != '#')
+        {
+            text.append(line);
+            text.push_back('\n');
+        }
+
+        pos = line_end + 1;
+    }
+
+    // Blank lines before the next dialog are not part of this one
+    while (!text.empty() && text.back() == '\n')
+        text.pop_back();
+
+    if (text.empty())
+        return std::wstring{};
+
+    const int size = MultiByteToWideChar(CP_UTF8, 0, text.data(), static_cast<int>(text.size()), NULL, 0);
+    std::wstring wide_text(size, L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, text.data(), static_cast<int>(text.size()), wide_text.data(), size);
+
+    return wide_text;
+}
+
+void Conversation::CreatePage()
+{
+    const size_t first = m_CurrentPage * m_PageLines;
+    const size_t last = std::min(first + m_PageLines, m_pLayout->GetNumLines());
+
+    std::wstring page_text;
+    for (size_t i = first; i < last; i++)
+    {
+        if (i > first)
+            page_text += L'\n';
+
+        page_text += m_pLayout->GetLine(i);
+    }
+
+    // The lines already fit, so laying the page out again keeps the same breaks
+    m_pPage = std::make_shared<const TextLayout>(page_text, m_pLayout->GetWidth());
+}
+
+Conversation::Conversation(const std::wstring& text, int width, size_t page_lines)
+    : m_pLayout{ std::make_shared<const TextLayout>(text, width) }, m_pPage{ nullptr }
+    , m_PageLines{ std::max(page_lines, size_t{ 1 }) }, m_CurrentPage{ 0 }
+{
+    CreatePage();
+}
+
+const size_t Conversation::GetNumPages() const
+{
+    return (m_pLayout->GetNumLines() + m_PageLines - 1) / m_PageLines;
+}
+
+bool Conversation::NextPage()
+{
+    if (IsLastPage())
+        return false;
+
+    m_CurrentPage++;
+    CreatePage();
+
+    return true;
+}
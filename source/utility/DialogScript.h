@@ -0,0 +1,67 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <memory>
+#include <Windows.h>
+#include "TextLayout.h"
+
+/*
+* Dialog script file mapped into memory and indexed by dialog id.
+* A dialog starts with an "@id" line and runs until the next "@" line, lines starting with '#' are comments.
+* Opening the script only builds the index, the text of a dialog is decoded when it is asked for.
+*/
+class DialogScript
+{
+private:
+    HANDLE m_hFile, m_hMapping;
+    const char* m_pData;
+    size_t m_Size;
+
+    // Dialog id to the raw UTF-8 body, both view the mapped file
+    std::unordered_map<std::string_view, std::string_view> m_Index;
+
+    bool Map(const std::string& filepath);
+    void Unmap();
+    void BuildIndex();
+
+public:
+    DialogScript(const std::string& filepath);
+    ~DialogScript();
+
+    DialogScript(const DialogScript&) = delete;
+    DialogScript& operator=(const DialogScript&) = delete;
+
+    inline const bool IsOpen() const { return m_pData != nullptr; }
+    inline const size_t GetNumDialogs() const { return m_Index.size(); }
+    inline const bool HasDialog(std::string_view id) const { return m_Index.find(id) != m_Index.end(); }
+
+    // Each line of the dialog becomes a line break in the returned text
+    std::wstring GetText(std::string_view id) const;
+};
+
+/*
+* The active dialog, laid out once for the Typewriter box and split into pages of page_lines lines.
+* Pages are created as they are reached, so only the current one is kept.
+*/
+class Conversation
+{
+private:
+    std::shared_ptr<const TextLayout> m_pLayout, m_pPage;
+    size_t m_PageLines, m_CurrentPage;
+
+    void CreatePage();
+
+public:
+    Conversation(const std::wstring& text, int width, size_t page_lines);
+    ~Conversation() = default;
+
+    inline const size_t GetCurrentPage() const { return m_CurrentPage; }
+    const size_t GetNumPages() const;
+    inline const bool IsLastPage() const { return m_CurrentPage + 1 >= GetNumPages(); }
+
+    // Returns false when there are no more pages
+    bool NextPage();
+    inline std::shared_ptr<const TextLayout> GetPage() const { return m_pPage; }
+};
@@ -1,5 +1,5 @@
 #include "Globals.h"
-#include  "trpg_utilities.h"
+#include <cwchar>
 
 std::unique_ptr<TRPG_Globals> TRPG_Globals::m_pInstance = nullptr;
 
@@ -7,7 +7,8 @@ TRPG_Globals::TRPG_Globals()
     : m_GameTime{ 0 }
     , m_SavedGameTime{ 0 }
     , m_Timer{}
-
+    , m_sTime{ L"00:00:00" }
+    , m_TimeStringSecond{ 0 }
 {
     m_Timer.Start();
 }
@@ -25,13 +26,20 @@ void TRPG_Globals::Update()
     m_GameTime = m_Timer.ElapsedSec() + m_SavedGameTime;
 }
 
-const std::wstring TRPG_Globals::GetTime()
+const std::wstring& TRPG_Globals::GetTime()
 {
+    if (m_GameTime == m_TimeStringSecond)
+        return m_sTime;
+
     int hours = m_GameTime / 3600;
     int minutes = (m_GameTime % 3600) / 60;
     int seconds = m_GameTime % 60;
 
-    std::wstring time{ PadNumbers(hours) + L":" + PadNumbers(minutes) + L":" + PadNumbers(seconds) };
+    wchar_t time[32];
+    const int length = std::swprintf(time, 32, L"%02d:%02d:%02d", hours, minutes, seconds);
+
+    m_sTime.assign(time, length > 0 ? length : 0);
+    m_TimeStringSecond = m_GameTime;
 
-    return time;
+    return m_sTime;
 }
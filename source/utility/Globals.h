@@ -10,6 +10,10 @@ private:
     int m_GameTime, m_SavedGameTime;
     Timer m_Timer;
 
+    // Play time shown as hh:mm:ss, only rebuilt when the second changes
+    std::wstring m_sTime;
+    int m_TimeStringSecond;
+
     TRPG_Globals();
 
     static std::unique_ptr<TRPG_Globals> m_pInstance;
@@ -19,5 +23,5 @@ public:
     const int GetGameTime() const { return m_GameTime; }
     void SetSaveGameTime(int saved_time) { m_SavedGameTime = saved_time; }
     void Update();
-    const std::wstring GetTime();
+    const std::wstring& GetTime();
 };
@@ -0,0 +1,276 @@
+#include "ItemCatalog.h"
+#include "ItemCreator.h"
+#include "trpg_utilities.h"
+#include "../Logger.h"
+#include "../Profiler.h"
+#include <tinyxml2.h>
+#include <cstdlib>
+
+using namespace tinyxml2;
+
+namespace
+{
+    WeaponProperties CreateWeaponProperties(XMLElement* xmlElement)
+    {
+        XMLElement* pWeaponProps = xmlElement->FirstChildElement("WeaponProperties");
+        if (!pWeaponProps)
+            return WeaponProperties();
+
+        XMLElement* pAttackPwr = pWeaponProps->FirstChildElement("AttackPwr");
+        int attackPwr = pAttackPwr ? atoi(pAttackPwr->GetText()) : 0;
+
+        XMLElement* pWeaponType = pWeaponProps->FirstChildElement("WeaponType");
+        const std::string weaponTypeStr = pWeaponType ? std::string{ pWeaponType->GetText() } : "Sword";
+        WeaponProperties::WeaponType type = WeaponTypeFromString(weaponTypeStr);
+
+        return WeaponProperties(attackPwr, type);
+    }
+
+    ArmourProperties CreateArmorProperties(XMLElement* xmlElement)
+    {
+        XMLElement* pArmourProps = xmlElement->FirstChildElement("ArmourProperties");
+        if (!pArmourProps)
+            return ArmourProperties();
+
+        XMLElement* pDefencePwr = pArmourProps->FirstChildElement("DefencePwr");
+        int defencePwr = pDefencePwr ? atoi(pDefencePwr->GetText()) : 0;
+
+        XMLElement* pArmourType = pArmourProps->FirstChildElement("ArmourType");
+        const std::string armour_type_str = pArmourType ? std::string{ pArmourType->GetText() } : "";
+        ArmourProperties::ArmourType type = ArmourTypeFromString(armour_type_str);
+
+        return ArmourProperties(defencePwr, type);
+    }
+
+    StatModifier CreateStatModifier(XMLElement* xmlElement)
+    {
+        XMLElement* pStatModifier = xmlElement->FirstChildElement("StatModifier");
+        if (!pStatModifier)
+            return StatModifier();
+
+        XMLElement* pModifierVal = pStatModifier->FirstChildElement("ModValue");
+        int mod_value = pModifierVal ? atoi(pModifierVal->GetText()) : 0;
+
+        XMLElement* pModifierType = pStatModifier->FirstChildElement("ModType");
+        const std::string mod_type_str = pModifierType ? std::string{ pModifierType->GetText() } : "";
+        StatModifier::ModifierType mod_type = ModifierTypeFromString(mod_type_str);
+
+        XMLElement* pElementalType = pStatModifier->FirstChildElement("ElementalType");
+        const std::string elemental_type_str = pElementalType ? std::string{ pElementalType->GetText() } : "";
+        StatModifier::ElementalType elemental_type = ElementalTypeFromString(elemental_type_str);
+
+        return StatModifier(mod_value, mod_type, elemental_type);
+    }
+
+    // The text of a child element, nullptr when it is missing or empty
+    const char* GetChildText(XMLElement* xmlElement, const char* name)
+    {
+        XMLElement* pChild = xmlElement->FirstChildElement(name);
+        return pChild ? pChild->GetText() : nullptr;
+    }
+}
+
+std::unique_ptr<ItemCatalog> ItemCatalog::m_pInstance = nullptr;
+
+ItemCatalog::ItemCatalog()
+    : m_Items{}, m_Equipment{}, m_ItemsByName{}, m_EquipmentByName{}
+{
+}
+
+ItemCatalog& ItemCatalog::GetInstance()
+{
+    if (!m_pInstance)
+        m_pInstance.reset(new ItemCatalog());
+
+    return *m_pInstance;
+}
+
+bool ItemCatalog::LoadItems(const std::string& filepath)
+{
+    TRPG_PROFILE_SCOPE("ItemCatalog::LoadItems");
+
+    XMLDocument document;
+
+    if (document.LoadFile(filepath.c_str()) != XML_SUCCESS)
+    {
+        TRPG_LOGF(LogLevel::ERR, LogCategory::LOADER, "Failed to load items [{}] -- {}", filepath, document.ErrorStr());
+        return false;
+    }
+
+    XMLElement* pRootElement = document.RootElement();
+    XMLElement* pItems = pRootElement ? pRootElement->FirstChildElement("Items") : nullptr;
+
+    if (!pItems)
+    {
+        TRPG_LOGF(LogLevel::ERR, LogCategory::LOADER, "Failed to get the Items from [{}]", filepath);
+        return false;
+    }
+
+    for (XMLElement* pItem = pItems->FirstChildElement("Item"); pItem; pItem = pItem->NextSiblingElement("Item"))
+    {
+        const char* name = GetChildText(pItem, "Name");
+        const char* type = GetChildText(pItem, "Type");
+        const char* desc = GetChildText(pItem, "Description");
+        const char* value = GetChildText(pItem, "Value");
+        const char* buy_price = GetChildText(pItem, "BuyPrice");
+
+        if (!name || !type || !desc || !value || !buy_price)
+        {
+            TRPG_LOGF(LogLevel::ERR, LogCategory::LOADER, "Item [{}] in [{}] is missing a value", name ? name : "", filepath);
+            continue;
+        }
+
+        Item::Definition definition{
+            .name = CharToWide(name),
+            .description = CharToWide(desc),
+            .type = ItemTypeFromString(type),
+            .value = atoi(value),
+            .buyPrice = atoi(buy_price)
+        };
+        definition.sellPrice = definition.buyPrice / 2;
+
+        if (definition.value < -1 || definition.buyPrice < 1)
+        {
+            TRPG_LOGF(LogLevel::ERR, LogCategory::LOADER, "Item [{}] value or buy price is below minimum!", name);
+            continue;
+        }
+
+        AddItem(std::move(definition));
+    }
+
+    TRPG_LOGF(LogLevel::INFO, LogCategory::LOADER, "Loaded items from [{}]", filepath);
+    return true;
+}
+
+bool ItemCatalog::LoadEquipment(const std::string& filepath, bool weapons)
+{
+    TRPG_PROFILE_SCOPE("ItemCatalog::LoadEquipment");
+
+    XMLDocument document;
+
+    if (document.LoadFile(filepath.c_str()) != XML_SUCCESS)
+    {
+        TRPG_LOGF(LogLevel::ERR, LogCategory::LOADER, "Failed to load the equipment file [{}] -- {}", filepath, document.ErrorStr());
+        return false;
+    }
+
+    XMLElement* pRootElement = document.RootElement();
+    XMLElement* pEquipment = pRootElement ? pRootElement->FirstChildElement(weapons ? "Weapons" : "Arms") : nullptr;
+
+    if (!pEquipment)
+    {
+        TRPG_LOGF(LogLevel::ERR, LogCategory::LOADER, "Failed to get the Equipment from [{}]", filepath);
+        return false;
+    }
+
+    const char* element_name = weapons ? "Weapon" : "Armour";
+
+    for (XMLElement* pItem = pEquipment->FirstChildElement(element_name); pItem; pItem = pItem->NextSiblingElement(element_name))
+    {
+        const char* name = GetChildText(pItem, "Name");
+        const char* type = GetChildText(pItem, "Type");
+        const char* desc = GetChildText(pItem, "Description");
+        const char* buy_price = GetChildText(pItem, "BuyPrice");
+
+        if (!name || !type || !desc || !buy_price)
+        {
+            TRPG_LOGF(LogLevel::ERR, LogCategory::LOADER, "Equipment [{}] in [{}] is missing a value", name ? name : "", filepath);
+            continue;
+        }
+
+        Equipment::Definition definition{
+            .name = CharToWide(name),
+            .description = CharToWide(desc),
+            .type = EquipTypeFromString(type),
+            .buyPrice = atoi(buy_price),
+            .statModifier = CreateStatModifier(pItem)
+        };
+        definition.sellPrice = definition.buyPrice / 2;
+
+        if (definition.buyPrice < 1)
+        {
+            TRPG_LOGF(LogLevel::ERR, LogCategory::LOADER, "Equipment [{}] buy price was below minimum!", name);
+            continue;
+        }
+
+        if (definition.type == Equipment::EquipType::WEAPON)
+            definition.properties.weapon = CreateWeaponProperties(pItem);
+        else if (definition.type == Equipment::EquipType::ARMOUR)
+            definition.properties.armour = CreateArmorProperties(pItem);
+
+        AddEquipment(std::move(definition));
+    }
+
+    TRPG_LOGF(LogLevel::INFO, LogCategory::LOADER, "Loaded equipment from [{}]", filepath);
+    return true;
+}
+
+const Item::Definition& ItemCatalog::AddItem(Item::Definition definition)
+{
+    if (auto it = m_ItemsByName.find(definition.name); it != m_ItemsByName.end())
+    {
+        TRPG_LOGF(LogLevel::INFO, LogCategory::LOADER, "Item [{}] is already defined", WideToStr(definition.name.Get()));
+        return *it->second;
+    }
+
+    definition.id = static_cast<uint32_t>(m_Items.size()) + 1;
+    const Item::Definition& stored = m_Items.emplace_back(std::move(definition));
+    m_ItemsByName.emplace(stored.name, &stored);
+    return stored;
+}
+
+const Equipment::Definition& ItemCatalog::AddEquipment(Equipment::Definition definition)
+{
+    if (auto it = m_EquipmentByName.find(definition.name); it != m_EquipmentByName.end())
+    {
+        TRPG_LOGF(LogLevel::INFO, LogCategory::LOADER, "Equipment [{}] is already defined", WideToStr(definition.name.Get()));
+        return *it->second;
+    }
+
+    definition.id = static_cast<uint32_t>(m_Equipment.size()) + 1;
+    const Equipment::Definition& stored = m_Equipment.emplace_back(std::move(definition));
+    m_EquipmentByName.emplace(stored.name, &stored);
+    return stored;
+}
+
+const Item::Definition* ItemCatalog::FindItem(InternedString name) const
+{
+    auto it = m_ItemsByName.find(name);
+    return it != m_ItemsByName.end() ? it->second : nullptr;
+}
+
+const Equipment::Definition* ItemCatalog::FindEquipment(InternedString name) const
+{
+    auto it = m_EquipmentByName.find(name);
+    return it != m_EquipmentByName.end() ? it->second : nullptr;
+}
+
+const Item::Definition* ItemCatalog::GetItem(uint32_t id) const
+{
+    return id > 0 && id <= m_Items.size() ? &m_Items[id - 1] : nullptr;
+}
+
+const Equipment::Definition* ItemCatalog::GetEquipment(uint32_t id) const
+{
+    return id > 0 && id <= m_Equipment.size() ? &m_Equipment[id - 1] : nullptr;
+}
+
+std::shared_ptr<Item> ItemCatalog::CreateItem(const Item::Definition& definition, int count) const
+{
+    auto item = ItemCreator::CreateItem(definition);
+
+    if (item && count > 1)
+        item->AddItem(count - 1);
+
+    return item;
+}
+
+std::shared_ptr<Equipment> ItemCatalog::CreateEquipment(const Equipment::Definition& definition, int count) const
+{
+    auto equipment = ItemCreator::CreateEquipment(definition);
+
+    if (equipment && count > 1)
+        equipment->Add(count - 1);
+
+    return equipment;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "../Item.h"
+#include "../Equipment.h"
+#include "StringTable.h"
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+/*
+* Every item and piece of equipment the game knows about, loaded once at startup.
+* Definitions never change after they are added, the items in an inventory point at them and only hold
+* their own count and state, so copies of the same item share one name, description and set of prices.
+*/
+class ItemCatalog
+{
+private:
+    // A deque never moves its elements, so the definitions handed out stay valid; indexed by id - 1
+    std::deque<Item::Definition> m_Items;
+    std::deque<Equipment::Definition> m_Equipment;
+    std::unordered_map<InternedString, const Item::Definition*> m_ItemsByName;
+    std::unordered_map<InternedString, const Equipment::Definition*> m_EquipmentByName;
+
+    static std::unique_ptr<ItemCatalog> m_pInstance;
+
+    ItemCatalog();
+
+public:
+    static ItemCatalog& GetInstance();
+
+    // Adds every valid definition in the file, invalid ones are logged and skipped
+    bool LoadItems(const std::string& filepath);
+    bool LoadEquipment(const std::string& filepath, bool weapons = true);
+
+    // The id of the definition is assigned here, when the name is already taken the first definition is kept
+    const Item::Definition& AddItem(Item::Definition definition);
+    const Equipment::Definition& AddEquipment(Equipment::Definition definition);
+
+    // nullptr when there is no such definition
+    const Item::Definition* FindItem(InternedString name) const;
+    const Equipment::Definition* FindEquipment(InternedString name) const;
+    const Item::Definition* GetItem(uint32_t id) const;
+    const Equipment::Definition* GetEquipment(uint32_t id) const;
+
+    std::shared_ptr<Item> CreateItem(const Item::Definition& definition, int count = 1) const;
+    std::shared_ptr<Equipment> CreateEquipment(const Equipment::Definition& definition, int count = 1) const;
+
+    inline const size_t GetNumItems() const { return m_Items.size(); }
+    inline const size_t GetNumEquipment() const { return m_Equipment.size(); }
+};
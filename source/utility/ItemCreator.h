@@ -5,6 +5,7 @@
 #include "../Item.h"
 #include "../Equipment.h"
 #include "../Potion.h"
+#include "ItemPool.h"
 
 class ItemCreator
 {
@@ -13,7 +14,12 @@ private:
         requires std::constructible_from<T, Args...>
     static std::shared_ptr<T> Create(Args&& ...args)
     {
+        // Each item type has its own pool, define TRPG_NO_ITEM_POOL to compare against the global allocator
+#ifdef TRPG_NO_ITEM_POOL
         return std::make_shared<T>(std::forward<Args>(args) ...);
+#else
+        return std::allocate_shared<T>(PoolAllocator<T>{}, std::forward<Args>(args) ...);
+#endif
     }
 
     template <typename T, typename ...Args>
@@ -23,21 +29,31 @@ private:
     }
 
 public:
-    template <class ...Args>
-    static std::shared_ptr<Item> CreateItem(Item::ItemType type, Args&& ...args)
+    // Whether CreateItem and CreateEquipment have a class for the definition's type
+    static bool CanCreateItem(const Item::Definition& definition)
     {
-        switch (type)
+        return definition.type == Item::ItemType::HEALTH;
+    }
+
+    static bool CanCreateEquipment(const Equipment::Definition& definition)
+    {
+        return definition.type == Equipment::EquipType::WEAPON || definition.type == Equipment::EquipType::ARMOUR;
+    }
+
+    static std::shared_ptr<Item> CreateItem(const Item::Definition& definition)
+    {
+        switch (definition.type)
         {
         case Item::ItemType::HEALTH:
-            return Create<Potion>(std::forward<Args>(args) ...);
+            return Create<Potion>(definition);
         case Item::ItemType::REVIVE:
-            //return Create<Potion>(std::forward<Args>(args) ...);
+            //return Create<Potion>(definition);
         case Item::ItemType::STATUS_EFFECT:
-            //return Create<STATUS_EFFECT>(std::forward<Args>(args) ...);
+            //return Create<STATUS_EFFECT>(definition);
         case Item::ItemType::BATTLE:
-            //return Create<BATTLE>(std::forward<Args>(args) ...);
+            //return Create<BATTLE>(definition);
         case Item::ItemType::KEY_ITEM:
-            //return Create<KEY_ITEM>(std::forward<Args>(args) ...);
+            //return Create<KEY_ITEM>(definition);
         case Item::ItemType::NO_TYPE:
             return nullptr;
         default:
@@ -45,18 +61,16 @@ public:
         }
     }
 
-    template <class ...Args>
-    static std::shared_ptr<Equipment> CreateEquipment(Equipment::EquipType type, WeaponProperties weapon_props,
-        ArmourProperties armour_props, StatModifier stat_mod, Args&& ...args)
+    static std::shared_ptr<Equipment> CreateEquipment(const Equipment::Definition& definition)
     {
-        switch (type)
+        switch (definition.type)
         {
         case Equipment::EquipType::WEAPON:
-            return Create<Weapon>(std::forward<Args>(args)..., weapon_props, stat_mod);
+            return Create<Weapon>(definition);
         case Equipment::EquipType::ARMOUR:
-            return Create<Armour>(std::forward<Args>(args)..., armour_props, stat_mod);
+            return Create<Armour>(definition);
         case Equipment::EquipType::RELIC:
-            // return Create<Accessory>(std::forward<Args>(args)...);
+            // return Create<Accessory>(definition);
         case Equipment::EquipType::NO_TYPE:
             return nullptr;
         default:
@@ -0,0 +1,54 @@
+#include "ItemPool.h"
+#include <algorithm>
+
+namespace
+{
+    constexpr size_t AlignUp(size_t size, size_t alignment)
+    {
+        return (size + alignment - 1) / alignment * alignment;
+    }
+}
+
+SlabPool::SlabPool(size_t block_size, size_t alignment)
+    : m_Slabs{}, m_pFreeList{ nullptr }
+    , m_BlockSize{ AlignUp(std::max(block_size, sizeof(FreeBlock)), std::max(alignment, alignof(FreeBlock))) }
+    , m_NumAllocated{ 0 }
+{
+}
+
+void SlabPool::AddSlab()
+{
+    auto slab = std::make_unique<std::byte[]>(m_BlockSize * BLOCKS_PER_SLAB);
+
+    // Linked in reverse so blocks are handed out from the start of the slab
+    for (size_t i = BLOCKS_PER_SLAB; i > 0; i--)
+    {
+        auto* block = reinterpret_cast<FreeBlock*>(slab.get() + (i - 1) * m_BlockSize);
+        block->pNext = m_pFreeList;
+        m_pFreeList = block;
+    }
+
+    m_Slabs.push_back(std::move(slab));
+}
+
+void* SlabPool::Allocate()
+{
+    if (!m_pFreeList)
+        AddSlab();
+
+    FreeBlock* block = m_pFreeList;
+    m_pFreeList = block->pNext;
+    m_NumAllocated++;
+    return block;
+}
+
+void SlabPool::Deallocate(void* block)
+{
+    if (!block)
+        return;
+
+    auto* free_block = static_cast<FreeBlock*>(block);
+    free_block->pNext = m_pFreeList;
+    m_pFreeList = free_block;
+    m_NumAllocated--;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+/*
+* Hands out fixed size blocks carved from slabs of BLOCKS_PER_SLAB, freed blocks are kept on a list and reused.
+* Only a new slab calls the global allocator, so once a type has enough slabs creating and destroying
+* objects of it does not allocate, and the objects of one type sit next to each other.
+* Only used from the game thread.
+*/
+class SlabPool
+{
+public:
+    static constexpr size_t BLOCKS_PER_SLAB = 256;
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock* pNext;
+    };
+
+    std::vector<std::unique_ptr<std::byte[]>> m_Slabs;
+    FreeBlock* m_pFreeList;
+    size_t m_BlockSize;
+    size_t m_NumAllocated;
+
+    void AddSlab();
+
+public:
+    SlabPool(size_t block_size, size_t alignment);
+    ~SlabPool() = default;
+
+    SlabPool(const SlabPool&) = delete;
+    SlabPool& operator=(const SlabPool&) = delete;
+
+    void* Allocate();
+    void Deallocate(void* block);
+
+    inline const size_t GetNumSlabs() const { return m_Slabs.size(); }
+    inline const size_t GetNumAllocated() const { return m_NumAllocated; }
+};
+
+// The pool for blocks of T, one per type
+template <typename T>
+SlabPool& GetSlabPool()
+{
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "Slabs are only aligned for new");
+
+    // Never destroyed, items held by other singletons can be released after this would have been
+    static SlabPool* pool = new SlabPool(sizeof(T), alignof(T));
+    return *pool;
+}
+
+/*
+* Allocator for std::allocate_shared, the object and its control block are one block of the pool for that pair.
+* Stateless, every copy uses the same pool.
+*/
+template <typename T>
+class PoolAllocator
+{
+public:
+    using value_type = T;
+
+    PoolAllocator() = default;
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+    T* allocate(size_t count)
+    {
+        if (count != 1)
+            return static_cast<T*>(::operator new(count * sizeof(T)));
+
+        return static_cast<T*>(GetSlabPool<T>().Allocate());
+    }
+
+    void deallocate(T* memory, size_t count) noexcept
+    {
+        if (count != 1)
+        {
+            ::operator delete(memory);
+            return;
+        }
+
+        GetSlabPool<T>().Deallocate(memory);
+    }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U>&) const noexcept { return true; }
+};
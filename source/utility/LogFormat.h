@@ -0,0 +1,177 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// Largest number of argument bytes a single message can carry, anything past it is cut
+constexpr size_t LOG_MAX_PAYLOAD = 256;
+
+enum class LogArgType : uint8_t { INT = 0, UINT, FLOAT, STRING };
+
+/*
+* A binary log starts with LOG_BINARY_MAGIC followed by entries that each start with a LogEntry byte.
+* SITE: u32 id, u8 level, u8 category, u32 line, then the format, file and function as u16 length strings
+* MESSAGE: u32 site id, i64 time in ms since the epoch, u16 payload length and the payload
+* DROPPED: u64 number of messages lost because the queue was full
+*/
+constexpr char LOG_BINARY_MAGIC[8] = { 'T', 'R', 'P', 'G', 'L', 'O', 'G', '1' };
+
+enum class LogEntry : uint8_t { SITE = 'S', MESSAGE = 'M', DROPPED = 'D' };
+
+// Indexed by LogLevel and LogCategory
+constexpr const char* LOG_LEVEL_NAMES[] = { "TRACE", "LOG", "WARN", "ERROR", "NONE" };
+constexpr const char* LOG_CATEGORY_NAMES[] = { "GENERAL", "INPUT", "STATE", "INVENTORY", "LOADER", "UI" };
+
+/*
+* Copies log arguments into a buffer as a type byte followed by their raw bytes.
+* Numbers are always 8 bytes, strings are a 2 byte length and their characters.
+* Arguments that do not fit are left out, and their {} are written as they are.
+*/
+class LogArgWriter
+{
+private:
+    char* m_pBuffer;
+    size_t m_Capacity, m_Length;
+    // Set once an argument did not fit, the ones after it are dropped too so none of them end up in the wrong {}
+    bool m_bFull;
+
+    void AddBytes(LogArgType type, const void* data, size_t size)
+    {
+        if (m_bFull || m_Length + 1 + size > m_Capacity)
+        {
+            m_bFull = true;
+            return;
+        }
+
+        m_pBuffer[m_Length++] = static_cast<char>(type);
+        std::memcpy(m_pBuffer + m_Length, data, size);
+        m_Length += size;
+    }
+
+    void AddString(std::string_view text)
+    {
+        if (m_bFull || m_Length + 3 > m_Capacity)
+        {
+            m_bFull = true;
+            return;
+        }
+
+        const uint16_t length = static_cast<uint16_t>(std::min(text.size(), m_Capacity - m_Length - 3));
+
+        m_pBuffer[m_Length++] = static_cast<char>(LogArgType::STRING);
+        std::memcpy(m_pBuffer + m_Length, &length, sizeof(length));
+        std::memcpy(m_pBuffer + m_Length + sizeof(length), text.data(), length);
+        m_Length += sizeof(length) + length;
+    }
+
+public:
+    LogArgWriter(char* buffer, size_t capacity) : m_pBuffer{ buffer }, m_Capacity{ capacity }, m_Length{ 0 }, m_bFull{ false } {}
+
+    template <typename T>
+    void Add(const T& value)
+    {
+        if constexpr (std::is_same_v<T, char>)
+            AddString(std::string_view{ &value, 1 });
+        else if constexpr (std::is_same_v<T, bool>)
+        {
+            const uint64_t number = value ? 1 : 0;
+            AddBytes(LogArgType::UINT, &number, sizeof(number));
+        }
+        else if constexpr (std::is_enum_v<T>)
+        {
+            const int64_t number = static_cast<int64_t>(value);
+            AddBytes(LogArgType::INT, &number, sizeof(number));
+        }
+        else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+        {
+            const int64_t number = value;
+            AddBytes(LogArgType::INT, &number, sizeof(number));
+        }
+        else if constexpr (std::is_integral_v<T>)
+        {
+            const uint64_t number = value;
+            AddBytes(LogArgType::UINT, &number, sizeof(number));
+        }
+        else if constexpr (std::is_floating_point_v<T>)
+        {
+            const double number = value;
+            AddBytes(LogArgType::FLOAT, &number, sizeof(number));
+        }
+        else
+        {
+            static_assert(std::is_convertible_v<const T&, std::string_view>, "Log arguments must be numbers, enums or strings");
+            AddString(std::string_view{ value });
+        }
+    }
+
+    inline const size_t GetLength() const { return m_Length; }
+};
+
+/*
+* Appends format to out with each {} replaced by the next argument in payload.
+* Shared with the log decoder, so a binary log reads the same as a text one.
+*/
+inline void FormatLogMessage(std::string& out, std::string_view format, const char* payload, size_t length)
+{
+    size_t read = 0;
+
+    for (size_t i = 0; i < format.size(); i++)
+    {
+        if (format[i] != '{' || i + 1 >= format.size() || format[i + 1] != '}' || read >= length)
+        {
+            out += format[i];
+            continue;
+        }
+
+        i++;
+        const LogArgType type = static_cast<LogArgType>(payload[read++]);
+
+        if (type == LogArgType::STRING)
+        {
+            uint16_t size = 0;
+            if (read + sizeof(size) > length)
+                break;
+
+            std::memcpy(&size, payload + read, sizeof(size));
+            read += sizeof(size);
+            size = static_cast<uint16_t>(std::min<size_t>(size, length - read));
+
+            out.append(payload + read, size);
+            read += size;
+            continue;
+        }
+
+        if (read + 8 > length)
+            break;
+
+        char number[32];
+        int number_length = 0;
+
+        if (type == LogArgType::INT)
+        {
+            int64_t value;
+            std::memcpy(&value, payload + read, sizeof(value));
+            number_length = std::snprintf(number, sizeof(number), "%lld", static_cast<long long>(value));
+        }
+        else if (type == LogArgType::UINT)
+        {
+            uint64_t value;
+            std::memcpy(&value, payload + read, sizeof(value));
+            number_length = std::snprintf(number, sizeof(number), "%llu", static_cast<unsigned long long>(value));
+        }
+        else
+        {
+            double value;
+            std::memcpy(&value, payload + read, sizeof(value));
+            number_length = std::snprintf(number, sizeof(number), "%g", value);
+        }
+
+        out.append(number, number_length > 0 ? number_length : 0);
+        read += 8;
+    }
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/*
+* Bounded lock-free queue for many producers and a single consumer.
+* Every slot has a sequence number that says whether it is free to write or ready to read,
+* so producers only race on the write position and a full queue fails instead of waiting.
+* The capacity is rounded up to a power of two.
+*/
+template <typename T>
+class MPSCRing
+{
+private:
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Slot[]> m_pSlots;
+    size_t m_Mask;
+
+    alignas(64) std::atomic<size_t> m_WritePos;
+    // Only the consumer touches the read position
+    alignas(64) size_t m_ReadPos;
+
+public:
+    MPSCRing(size_t capacity)
+        : m_pSlots{ nullptr }, m_Mask{ 0 }, m_WritePos{ 0 }, m_ReadPos{ 0 }
+    {
+        size_t size = 2;
+        while (size < capacity)
+            size <<= 1;
+
+        m_pSlots = std::make_unique<Slot[]>(size);
+        m_Mask = size - 1;
+
+        for (size_t i = 0; i < size; i++)
+            m_pSlots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    MPSCRing(const MPSCRing&) = delete;
+    MPSCRing& operator=(const MPSCRing&) = delete;
+
+    inline const size_t GetCapacity() const { return m_Mask + 1; }
+
+    // fill is called with the claimed slot's value, returns false when the queue is full
+    template <typename Fill>
+    bool TryPush(Fill&& fill)
+    {
+        size_t pos = m_WritePos.load(std::memory_order_relaxed);
+        Slot* slot = nullptr;
+
+        while (true)
+        {
+            slot = &m_pSlots[pos & m_Mask];
+            const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+            if (difference == 0)
+            {
+                if (m_WritePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (difference < 0)
+                return false;
+            else
+                pos = m_WritePos.load(std::memory_order_relaxed);
+        }
+
+        fill(slot->value);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    // read is called with the oldest value, returns false when the queue is empty
+    template <typename Read>
+    bool TryPop(Read&& read)
+    {
+        Slot& slot = m_pSlots[m_ReadPos & m_Mask];
+
+        if (slot.sequence.load(std::memory_order_acquire) != m_ReadPos + 1)
+            return false;
+
+        read(slot.value);
+        slot.sequence.store(m_ReadPos + m_Mask + 1, std::memory_order_release);
+        m_ReadPos++;
+
+        return true;
+    }
+};
@@ -0,0 +1,35 @@
+#include "Metrics.h"
+#include <cstring>
+
+MetricsRegistry::MetricsRegistry()
+    : m_Metrics{}, m_NumMetrics{ 0 }
+{
+}
+
+MetricsRegistry& MetricsRegistry::GetInstance()
+{
+    // Metrics register from any thread, a local static is constructed exactly once even when two threads get here first
+    static MetricsRegistry instance;
+    return instance;
+}
+
+size_t MetricsRegistry::Register(const char* name, MetricKind kind)
+{
+    // Metrics registered from more than one place share the slot
+    for (size_t i = 0; i < GetNumMetrics(); i++)
+    {
+        const char* other = GetName(i);
+        if (other && std::strcmp(other, name) == 0)
+            return i;
+    }
+
+    const size_t id = m_NumMetrics.fetch_add(1, std::memory_order_relaxed);
+    if (id >= MAX_METRICS)
+        return INVALID_METRIC;
+
+    m_Metrics[id].kind = kind;
+    m_Metrics[id].value.store(0, std::memory_order_relaxed);
+    m_Metrics[id].name.store(name, std::memory_order_release);
+
+    return id;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+enum class MetricKind { COUNTER = 0, GAUGE };
+
+/*
+* Fixed table of named metrics that any subsystem can register and update from any thread.
+* Registering claims a slot with an atomic increment and updates are relaxed atomics, so nothing takes a lock.
+* COUNTERs only go up and readers look at how much they changed, GAUGEs hold a current value.
+*/
+class MetricsRegistry
+{
+public:
+    static const size_t MAX_METRICS = 64;
+    static const size_t INVALID_METRIC = MAX_METRICS;
+
+private:
+    struct Metric
+    {
+        // Set last when registering, a slot with no name is not ready to be read
+        std::atomic<const char*> name{ nullptr };
+        std::atomic<int64_t> value{ 0 };
+        MetricKind kind{ MetricKind::COUNTER };
+    };
+
+    std::array<Metric, MAX_METRICS> m_Metrics;
+    std::atomic<size_t> m_NumMetrics;
+
+    MetricsRegistry();
+
+public:
+    static MetricsRegistry& GetInstance();
+
+    // name must be a string literal, or outlive the registry
+    size_t Register(const char* name, MetricKind kind);
+
+    inline void Add(size_t id, int64_t amount)
+    {
+        if (id < MAX_METRICS)
+            m_Metrics[id].value.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    inline void Set(size_t id, int64_t value)
+    {
+        if (id < MAX_METRICS)
+            m_Metrics[id].value.store(value, std::memory_order_relaxed);
+    }
+
+    inline const int64_t Get(size_t id) const
+    {
+        return id < MAX_METRICS ? m_Metrics[id].value.load(std::memory_order_relaxed) : 0;
+    }
+
+    inline const size_t GetNumMetrics() const { return std::min(m_NumMetrics.load(std::memory_order_acquire), MAX_METRICS); }
+    // Returns nullptr while the slot is still being registered
+    inline const char* GetName(size_t id) const { return id < MAX_METRICS ? m_Metrics[id].name.load(std::memory_order_acquire) : nullptr; }
+    inline const MetricKind GetKind(size_t id) const { return id < MAX_METRICS ? m_Metrics[id].kind : MetricKind::COUNTER; }
+};
+
+/*
+* Handle to a registered metric, meant to be kept as a static next to the code that updates it.
+*/
+class Metric
+{
+private:
+    size_t m_Id;
+
+public:
+    Metric(const char* name, MetricKind kind = MetricKind::COUNTER)
+        : m_Id{ MetricsRegistry::GetInstance().Register(name, kind) }
+    {
+    }
+
+    inline void Add(int64_t amount = 1) { MetricsRegistry::GetInstance().Add(m_Id, amount); }
+    inline void Set(int64_t value) { MetricsRegistry::GetInstance().Set(m_Id, value); }
+    inline const int64_t Get() const { return MetricsRegistry::GetInstance().Get(m_Id); }
+};
@@ -2,6 +2,7 @@
 #include <tinyxml2.h>
 #include <memory>
 #include<string>
+#include "../Profiler.h"
 
 template <typename T>
 class Parser
@@ -14,6 +15,8 @@ public:
 
 	tinyxml2::XMLError LoadFile(const std::string& filepath)
 	{
+		TRPG_PROFILE_SCOPE("Parser::LoadFile");
+
 		return m_pXMLDoc->LoadFile(filepath.c_str());
 	}
 
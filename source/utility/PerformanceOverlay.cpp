@@ -0,0 +1,111 @@
+#include "PerformanceOverlay.h"
+#include "Clock.h"
+#include "AllocationCounter.h"
+#include "../Console.h"
+#include <algorithm>
+#include <cwchar>
+
+const int64_t PerformanceOverlay::Percentile(double percent)
+{
+    if (m_SortedFrameTimes.empty())
+        return 0;
+
+    const size_t index = std::min(static_cast<size_t>(percent / 100.0 * m_SortedFrameTimes.size()), m_SortedFrameTimes.size() - 1);
+    std::nth_element(m_SortedFrameTimes.begin(), m_SortedFrameTimes.begin() + index, m_SortedFrameTimes.end());
+
+    return m_SortedFrameTimes[index];
+}
+
+void PerformanceOverlay::WriteLine(Console& console, int line, const char* label, double value, int precision)
+{
+    // Build the line in place and skip the write counter, the overlay should not add to the figures it shows
+    wchar_t text[WIDTH + 1];
+    std::fill(text, text + WIDTH, L' ');
+
+    int pos = 1;
+    for (const char* c = label; *c && pos < WIDTH - 12; c++)
+        text[pos++] = static_cast<wchar_t>(*c);
+
+    wchar_t number[32];
+    const int length = std::swprintf(number, 32, L"%.*f", precision, value);
+
+    if (length > 0 && length < WIDTH - pos)
+        std::copy(number, number + length, text + WIDTH - 1 - length);
+
+    const int x = console.GetScreenWidth() - WIDTH - 2;
+    console.WriteToBuffer(x, 1 + line, std::wstring_view{ text, static_cast<size_t>(WIDTH) }, LIGHT_AQUA);
+}
+
+void PerformanceOverlay::Clear(Console& console)
+{
+    wchar_t blank[WIDTH];
+    std::fill(blank, blank + WIDTH, L' ');
+
+    const int x = console.GetScreenWidth() - WIDTH - 2;
+    for (int i = 0; i < m_NumLinesDrawn; i++)
+        console.WriteToBuffer(x, 1 + i, std::wstring_view{ blank, static_cast<size_t>(WIDTH) }, WHITE);
+
+    m_NumLinesDrawn = 0;
+}
+
+PerformanceOverlay::PerformanceOverlay()
+    : m_FrameTimesUS{}, m_NumFrames{ 0 }, m_FrameIndex{ 0 }
+    , m_PrevValues{}, m_FrameValues{}, m_PrevAllocations{ GetAllocationCount() }, m_FrameAllocations{ 0 }
+    , m_SortedFrameTimes{}, m_NumLinesDrawn{ 0 }, m_bVisible{ false }
+{
+    m_SortedFrameTimes.reserve(FRAME_WINDOW);
+}
+
+void PerformanceOverlay::Update()
+{
+    m_FrameTimesUS[m_FrameIndex] = Clock::GetInstance().GetFrameTimeUS();
+    m_FrameIndex = (m_FrameIndex + 1) % FRAME_WINDOW;
+    m_NumFrames = std::min(m_NumFrames + 1, FRAME_WINDOW);
+
+    const auto& metrics = MetricsRegistry::GetInstance();
+    for (size_t i = 0; i < metrics.GetNumMetrics(); i++)
+    {
+        const int64_t value = metrics.Get(i);
+        m_FrameValues[i] = metrics.GetKind(i) == MetricKind::COUNTER ? value - m_PrevValues[i] : value;
+        m_PrevValues[i] = value;
+    }
+
+    const uint64_t allocations = GetAllocationCount();
+    m_FrameAllocations = allocations - m_PrevAllocations;
+    m_PrevAllocations = allocations;
+}
+
+void PerformanceOverlay::Draw(Console& console)
+{
+    if (!m_bVisible)
+    {
+        // Remove the overlay once after it is hidden, the states do not redraw under it
+        if (m_NumLinesDrawn > 0)
+            Clear(console);
+
+        return;
+    }
+
+    m_SortedFrameTimes.assign(m_FrameTimesUS.begin(), m_FrameTimesUS.begin() + m_NumFrames);
+
+    int64_t total_us = 0;
+    for (const auto frame_time : m_SortedFrameTimes)
+        total_us += frame_time;
+
+    const double fps = total_us > 0 ? 1000000.0 * m_NumFrames / total_us : 0.0;
+
+    int line = 0;
+    WriteLine(console, line++, "FPS", fps, 1);
+    WriteLine(console, line++, "Frame p50 (ms)", Percentile(50.0) / 1000.0, 2);
+    WriteLine(console, line++, "Frame p99 (ms)", Percentile(99.0) / 1000.0, 2);
+    WriteLine(console, line++, "Allocations / frame", static_cast<double>(m_FrameAllocations), 0);
+
+    const auto& metrics = MetricsRegistry::GetInstance();
+    for (size_t i = 0; i < metrics.GetNumMetrics(); i++)
+    {
+        if (const char* name = metrics.GetName(i))
+            WriteLine(console, line++, name, static_cast<double>(m_FrameValues[i]), 0);
+    }
+
+    m_NumLinesDrawn = std::max(m_NumLinesDrawn, line);
+}
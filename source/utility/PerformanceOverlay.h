@@ -0,0 +1,45 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include "Metrics.h"
+
+class Console;
+
+/*
+* Frame time percentiles, allocations and every registered metric, drawn on top of whatever state is active.
+* COUNTER metrics show how much they changed in the last frame, GAUGE metrics show their value.
+*/
+class PerformanceOverlay
+{
+private:
+    static const size_t FRAME_WINDOW = 240;
+    static const int WIDTH = 36;
+
+    std::array<int64_t, FRAME_WINDOW> m_FrameTimesUS;
+    size_t m_NumFrames, m_FrameIndex;
+
+    std::array<int64_t, MetricsRegistry::MAX_METRICS> m_PrevValues, m_FrameValues;
+    uint64_t m_PrevAllocations, m_FrameAllocations;
+
+    // Reserved once, so sorting the frame times does not allocate
+    std::vector<int64_t> m_SortedFrameTimes;
+    int m_NumLinesDrawn;
+    bool m_bVisible;
+
+    const int64_t Percentile(double percent);
+    void WriteLine(Console& console, int line, const char* label, double value, int precision);
+    void Clear(Console& console);
+
+public:
+    PerformanceOverlay();
+    ~PerformanceOverlay() = default;
+
+    // Samples the frame time and the metrics, called once per frame
+    void Update();
+    void Draw(Console& console);
+
+    inline void Toggle() { m_bVisible = !m_bVisible; }
+    inline const bool IsVisible() const { return m_bVisible; }
+};
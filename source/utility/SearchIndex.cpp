@@ -0,0 +1,122 @@
+#include "SearchIndex.h"
+#include <algorithm>
+#include <cwctype>
+
+std::wstring_view SearchIndex::GetName(size_t index) const
+{
+    return std::wstring_view{ m_sNames }.substr(m_Offsets[index], m_Offsets[index + 1] - m_Offsets[index]);
+}
+
+void SearchIndex::Narrow(const std::vector<size_t>& candidates, std::vector<size_t>& results) const
+{
+    results.clear();
+
+    // Prefix matches are listed before the names that only contain the query
+    size_t num_prefix = 0;
+    for (const auto& index : candidates)
+    {
+        if ((m_CharMasks[index] & m_QueryMask) != m_QueryMask)
+            continue;
+
+        const auto& pos = GetName(index).find(m_sQuery);
+        if (pos == std::wstring_view::npos)
+            continue;
+
+        results.push_back(index);
+
+        if (pos == 0)
+        {
+            std::swap(results[num_prefix], results.back());
+            num_prefix++;
+        }
+    }
+
+    // Swapping breaks the original order of the substring matches, restore it
+    std::sort(results.begin() + num_prefix, results.end());
+}
+
+SearchIndex::SearchIndex()
+    : m_sNames{}, m_Offsets{ 0 }, m_CharMasks{}
+    , m_sQuery{}, m_QueryMask{ 0 }, m_QueryMasks{}, m_Results{}, m_NumResults{ 0 }, m_AllNames{}
+{
+}
+
+void SearchIndex::Clear()
+{
+    m_sNames.clear();
+    m_Offsets.assign(1, 0);
+    m_CharMasks.clear();
+    m_AllNames.clear();
+    ClearQuery();
+}
+
+void SearchIndex::Reserve(size_t count)
+{
+    m_Offsets.reserve(count + 1);
+    m_CharMasks.reserve(count);
+    m_AllNames.reserve(count);
+}
+
+void SearchIndex::AddName(const std::wstring& name)
+{
+    uint64_t mask = 0;
+    for (const auto& character : name)
+    {
+        const wchar_t lower = static_cast<wchar_t>(std::towlower(character));
+        m_sNames += lower;
+        mask |= CharMask(lower);
+    }
+
+    m_AllNames.push_back(m_CharMasks.size());
+    m_CharMasks.push_back(mask);
+    m_Offsets.push_back(static_cast<uint32_t>(m_sNames.size()));
+}
+
+bool SearchIndex::Push(wchar_t character)
+{
+    const wchar_t lower = static_cast<wchar_t>(std::towlower(character));
+
+    m_QueryMasks.push_back(m_QueryMask);
+    m_QueryMask |= CharMask(lower);
+    m_sQuery += lower;
+
+    // Grown before taking the candidates, growing moves the result sets they point into
+    if (m_Results.size() <= m_NumResults)
+        m_Results.emplace_back();
+
+    // Anything matching the longer query also matched the shorter one
+    const auto& candidates = GetMatches();
+    auto& results = m_Results[m_NumResults];
+    Narrow(candidates, results);
+    m_NumResults++;
+
+    return !results.empty();
+}
+
+bool SearchIndex::Pop()
+{
+    if (m_sQuery.empty())
+        return false;
+
+    m_sQuery.pop_back();
+    m_QueryMask = m_QueryMasks.back();
+    m_QueryMasks.pop_back();
+    m_NumResults--;
+    return true;
+}
+
+void SearchIndex::ClearQuery()
+{
+    m_sQuery.clear();
+    m_QueryMask = 0;
+    m_QueryMasks.clear();
+    m_NumResults = 0;
+}
+
+const std::vector<size_t>& SearchIndex::GetMatches() const
+{
+    if (m_NumResults == 0)
+        return m_AllNames;
+
+    return m_Results[m_NumResults - 1];
+}
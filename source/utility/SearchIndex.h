@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+/*
+* Incremental name filter used by the Selector.
+* Names are lowercased once into a single buffer when the index is built. Every typed
+* character only narrows the previous result set, and backspace pops back to the previous
+* result instead of searching again.
+*/
+class SearchIndex
+{
+private:
+    std::wstring m_sNames;
+    std::vector<uint32_t> m_Offsets;
+    std::vector<uint64_t> m_CharMasks;
+
+    std::wstring m_sQuery;
+    uint64_t m_QueryMask;
+    std::vector<uint64_t> m_QueryMasks;
+    // One result set per query character, only the first m_NumResults are in use.
+    // The rest keep their memory for the next characters typed
+    std::vector<std::vector<size_t>> m_Results;
+    size_t m_NumResults;
+    std::vector<size_t> m_AllNames;
+
+    static uint64_t CharMask(wchar_t character) { return 1ull << (character & 63); }
+
+    std::wstring_view GetName(size_t index) const;
+    void Narrow(const std::vector<size_t>& candidates, std::vector<size_t>& results) const;
+
+public:
+    SearchIndex();
+    ~SearchIndex() = default;
+
+    void Clear();
+    void Reserve(size_t count);
+    void AddName(const std::wstring& name);
+
+    bool Push(wchar_t character);
+    bool Pop();
+    void ClearQuery();
+
+    const std::vector<size_t>& GetMatches() const;
+    inline const std::wstring& GetQuery() const { return m_sQuery; }
+    inline const size_t Size() const { return m_AllNames.size(); }
+};
@@ -1,9 +1,8 @@
 #include "ShopLoader.h"
 #include "../Logger.h"
 #include "../utility/trpg_utilities.h"
-#include "ItemCreator.h"
-#include "Equipment.Loader.h"
-#include "ItemLoader.h"
+#include "ItemCatalog.h"
+#include "../Profiler.h"
 
 using namespace tinyxml2;
 
@@ -18,9 +17,11 @@ ShopLoader::~ShopLoader()
 
 std::unique_ptr<ShopParameters> ShopLoader::CreateShopParametersFromFile(const std::string& shop_filepath)
 {
+	TRPG_PROFILE_SCOPE("ShopLoader::CreateShopParametersFromFile");
+
 	if (LoadFile(shop_filepath) != tinyxml2::XML_SUCCESS)
 	{
-		TRPG_ERROR("Failed to Load shop Parameters from [" + shop_filepath + "]");
+		TRPG_LOG_CAT(LogLevel::ERR, LogCategory::LOADER, "Failed to Load shop Parameters from [" + shop_filepath + "]");
 		return nullptr;
 	}
 
@@ -28,7 +29,7 @@ std::unique_ptr<ShopParameters> ShopLoader::CreateShopParametersFromFile(const s
 
 	if (!pRootElement)
 	{
-		TRPG_ERROR("Failed to get the root element");
+		TRPG_LOG_CAT(LogLevel::ERR, LogCategory::LOADER, "Failed to get the root element");
 		return nullptr;
 	}
 
@@ -36,7 +37,7 @@ std::unique_ptr<ShopParameters> ShopLoader::CreateShopParametersFromFile(const s
 
 	if (!pShopParams)
 	{
-		TRPG_ERROR("Failed to get the Shop Parameters");
+		TRPG_LOG_CAT(LogLevel::ERR, LogCategory::LOADER, "Failed to get the Shop Parameters");
 		return nullptr;
 	}
 
@@ -44,7 +45,7 @@ std::unique_ptr<ShopParameters> ShopLoader::CreateShopParametersFromFile(const s
 
 	if (!pShopType)
 	{
-		TRPG_ERROR("Failed to get the Shop Type");
+		TRPG_LOG_CAT(LogLevel::ERR, LogCategory::LOADER, "Failed to get the Shop Type");
 		return nullptr;
 	}
 
@@ -54,57 +55,43 @@ std::unique_ptr<ShopParameters> ShopLoader::CreateShopParametersFromFile(const s
 
 	if (!pInventory)
 	{
-		TRPG_ERROR("Failed to get the Shop Inventory");
+		TRPG_LOG_CAT(LogLevel::ERR, LogCategory::LOADER, "Failed to get the Shop Inventory");
 		return nullptr;
 	}
 
 	std::shared_ptr<Inventory> inventory = std::make_shared<Inventory>();
 	ShopParameters::ShopType shopType = ShopTypeFromString(shopTypeStr);
-	std::string definitionLocation{ "" };
-	bool itemLoader{ false };
-	bool weaponLoader{ false };
+	bool itemShop{ false };
 
 	switch (shopType)
 	{
 	case ShopParameters::ShopType::WEAPON:
-		definitionLocation = "./assets/xml_files/WeaponDefs.xml";
-		weaponLoader = true;
-		break;
 	case ShopParameters::ShopType::ARMOUR:
-		definitionLocation = "./assets/xml_files/ArmourDefs.xml";
-		break;
 	case ShopParameters::ShopType::RELIC:
-		definitionLocation = "./assets/xml_files/RelicDefs.xml";
 		break;
 	case ShopParameters::ShopType::ITEM:
-		definitionLocation = "./assets/xml_files/ItemDefs.xml";
-		itemLoader = true;
+		itemShop = true;
 		break;
 	case ShopParameters::ShopType::NOT_A_SHOP:
-		TRPG_ERROR("Invalid Shop Type");
+		TRPG_LOG_CAT(LogLevel::ERR, LogCategory::LOADER, "Invalid Shop Type");
 		return nullptr;
 	}
 
-	std::unique_ptr<ItemLoader> itemLoaderPtr{ nullptr };
-	if (itemLoader)
-		itemLoaderPtr = std::make_unique<ItemLoader>(definitionLocation);
-
-	std::unique_ptr<EquipmentLoader> equipmentLoaderPtr{ nullptr };
-	if (!itemLoader)
-		equipmentLoaderPtr = std::make_unique<EquipmentLoader>(definitionLocation, weaponLoader);
+	// The definitions were loaded with the catalog, the shop only lists them by name
+	ItemCatalog& catalog = ItemCatalog::GetInstance();
 
 	XMLElement* pShopItem = pInventory->FirstChildElement("ShopItem");
 
 	if (!pShopItem)
 	{
-		TRPG_ERROR("Failed to get the Shop Item");
+		TRPG_LOG_CAT(LogLevel::ERR, LogCategory::LOADER, "Failed to get the Shop Item");
 		return nullptr;
 	}
 
 	XMLElement* pItem = pShopItem->FirstChildElement(shopTypeStr.c_str());
 	if (!pItem)
 	{
-		TRPG_ERROR("Failed to get the first Item");
+		TRPG_LOG_CAT(LogLevel::ERR, LogCategory::LOADER, "Failed to get the first Item");
 		return nullptr;
 	}
 
@@ -113,24 +100,27 @@ std::unique_ptr<ShopParameters> ShopLoader::CreateShopParametersFromFile(const s
 		XMLElement* pName = pItem->FirstChildElement("Name");
 		if (!pName)
 		{
-			TRPG_ERROR("Failed to get item name!");
+			TRPG_LOG_CAT(LogLevel::ERR, LogCategory::LOADER, "Failed to get item name!");
 			return nullptr;
 		}
 
 		std::string name{ pName->GetText() };
 
-		if (itemLoader)
-		{
-			auto newItem = itemLoaderPtr->CreateObjectFromFile(name);
+		const InternedString item_name{ CharToWide(name.c_str()) };
 
-			if (newItem)
-				inventory->AddItem(std::move(newItem));
+		if (itemShop)
+		{
+			if (const auto* definition = catalog.FindItem(item_name))
+				inventory->AddItem(catalog.CreateItem(*definition));
+			else
+				TRPG_LOG_CAT(LogLevel::ERR, LogCategory::LOADER, "Item - [" + name + "] - does not exist");
 		}
 		else
 		{
-			auto newEquipment = equipmentLoaderPtr->CreateObjectFromFile(name);
-			if (newEquipment)
-				inventory->AddEquipment(std::move(newEquipment));
+			if (const auto* definition = catalog.FindEquipment(item_name))
+				inventory->AddEquipment(catalog.CreateEquipment(*definition));
+			else
+				TRPG_LOG_CAT(LogLevel::ERR, LogCategory::LOADER, "Item - [" + name + "] - does not exist");
 		}
 		pItem = pItem->NextSiblingElement(shopTypeStr.c_str());
 	}
@@ -139,7 +129,7 @@ std::unique_ptr<ShopParameters> ShopLoader::CreateShopParametersFromFile(const s
 
 	if (!shop_parameters)
 	{
-		TRPG_ERROR("Failed to create shop Parameters!");
+		TRPG_LOG_CAT(LogLevel::ERR, LogCategory::LOADER, "Failed to create shop Parameters!");
 		return nullptr;
 	}
 
@@ -0,0 +1,627 @@
+#include "StatFormula.h"
+#include "../Logger.h"
+#include "../Profiler.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <tinyxml2.h>
+
+#if !defined(TRPG_NO_SIMD) && (defined(_M_X64) || defined(__SSE2__))
+#define TRPG_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+using namespace tinyxml2;
+
+namespace
+{
+    // Names formulas use for the equipment slots, indexed by Stats::EquipSlots
+    const char* SLOT_NAMES[] = { "Weapon", "HeadGear", "Armour", "FootWear", "Relic" };
+
+    // Used until a formula file is loaded, and kept when it fails to load
+    const struct { StatId stat; const char* source; } DEFAULT_FORMULAS[] = {
+        { StatId::ATTACK, "Weapon + Strength + Intelligence / 5 + WillPower / 5" },
+        { StatId::DEFENSE, "HeadGear + Armour + FootWear + Strength / 5 + Intelligence / 5 + Speed / 5 + WillPower / 5" },
+    };
+
+    bool NameEquals(std::string_view name, std::wstring_view other)
+    {
+        return name.size() == other.size() &&
+            std::equal(name.begin(), name.end(), other.begin(), [](char a, wchar_t b) { return static_cast<wchar_t>(a) == b; });
+    }
+
+    // Returns NUM_STAT_INPUTS when the name is not a stat or slot
+    size_t FindInput(std::string_view name)
+    {
+        for (size_t i = 0; i < NUM_STATS; i++)
+        {
+            if (NameEquals(name, STAT_NAMES[i]))
+                return GetStatInput(static_cast<StatId>(i));
+        }
+
+        for (size_t i = 0; i < Stats::NUM_EQUIP_SLOTS; i++)
+        {
+            if (name == SLOT_NAMES[i])
+                return GetStatInput(static_cast<Stats::EquipSlots>(i));
+        }
+
+        return NUM_STAT_INPUTS;
+    }
+
+    // INT32_MIN / -1 does not fit and traps, it wraps around to INT32_MIN the same way negating it does
+    inline int Divide(int lhs, int rhs)
+    {
+        if (rhs == 0)
+            return 0;
+        if (rhs == -1)
+            return static_cast<int>(0u - static_cast<uint32_t>(lhs));
+
+        return lhs / rhs;
+    }
+
+    inline int Apply(FormulaOp op, int lhs, int rhs)
+    {
+        switch (op)
+        {
+        case FormulaOp::ADD: return lhs + rhs;
+        case FormulaOp::SUB: return lhs - rhs;
+        case FormulaOp::MUL: return lhs * rhs;
+        case FormulaOp::DIV: return Divide(lhs, rhs);
+        default: return 0;
+        }
+    }
+
+    /*
+    * The reciprocal of d scaled so that (n * magic) >> shift == n / d for every 0 <= n < 2^31
+    * (Granlund and Montgomery, the round up method with 31 bit numerators).
+    */
+    void SetDivisor(FormulaInstruction& instruction)
+    {
+        const uint64_t divisor = static_cast<uint64_t>(std::abs(static_cast<int64_t>(instruction.value)));
+
+        uint32_t log2 = 0;
+        while ((1ull << log2) < divisor)
+            log2++;
+
+        instruction.shift = static_cast<uint8_t>(31 + log2);
+        instruction.magic = static_cast<uint32_t>(((1ull << instruction.shift) + divisor - 1) / divisor);
+    }
+
+    constexpr int Dispatch(FormulaOp op, FormulaOperand operand)
+    {
+        return static_cast<int>(op) * 3 + static_cast<int>(operand);
+    }
+
+    inline int DivideByConstant(int lhs, const FormulaInstruction& instruction)
+    {
+        // The only value whose magnitude does not fit in 31 bits
+        if (lhs == INT32_MIN)
+            return Divide(lhs, instruction.value);
+
+        const uint32_t magnitude = static_cast<uint32_t>(lhs < 0 ? -lhs : lhs);
+        const int quotient = static_cast<int>((static_cast<uint64_t>(magnitude) * instruction.magic) >> instruction.shift);
+
+        return (lhs < 0) != (instruction.value < 0) ? -quotient : quotient;
+    }
+
+#ifdef TRPG_SIMD_SSE2
+    // The batch kernels work on four actors per SSE2 register, count does not have to be a multiple of four
+    const size_t LANES = 4;
+
+    inline __m128i MultiplyLanes(__m128i lhs, __m128i rhs)
+    {
+        // SSE2 only multiplies the even lanes to 64 bits, so the odd lanes are shifted down and done separately
+        const __m128i even = _mm_mul_epu32(lhs, rhs);
+        const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(lhs, 32), _mm_srli_epi64(rhs, 32));
+        return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+    }
+
+    // DivideByConstant for four lanes at once
+    inline __m128i DivideLanesByConstant(__m128i lhs, const FormulaInstruction& instruction)
+    {
+        const __m128i sign = _mm_srai_epi32(lhs, 31);
+        const __m128i magnitude = _mm_sub_epi32(_mm_xor_si128(lhs, sign), sign);
+        const __m128i magic = _mm_set1_epi32(static_cast<int>(instruction.magic));
+        const __m128i shift = _mm_cvtsi32_si128(instruction.shift);
+
+        // The shift is at least 31, so each quotient fits in the low half of its 64 bit product
+        const __m128i even = _mm_srl_epi64(_mm_mul_epu32(magnitude, magic), shift);
+        const __m128i odd = _mm_srl_epi64(_mm_mul_epu32(_mm_srli_epi64(magnitude, 32), magic), shift);
+        const __m128i quotient = _mm_or_si128(even, _mm_slli_epi64(odd, 32));
+
+        const __m128i result_sign = instruction.value < 0 ? _mm_xor_si128(sign, _mm_set1_epi32(-1)) : sign;
+        return _mm_sub_epi32(_mm_xor_si128(quotient, result_sign), result_sign);
+    }
+
+    // Runs one instruction over the first n / LANES * LANES values and returns how many it did
+    size_t ApplyLanes(const FormulaInstruction& instruction, int* lhs, const int* rhs, size_t n)
+    {
+        const __m128i int_min = _mm_set1_epi32(INT32_MIN);
+        size_t i = 0;
+
+        for (; i + LANES <= n; i += LANES)
+        {
+            __m128i* lanes = reinterpret_cast<__m128i*>(lhs + i);
+            const __m128i a = _mm_loadu_si128(lanes);
+            __m128i result;
+
+            switch (instruction.op)
+            {
+            case FormulaOp::ADD: result = _mm_add_epi32(a, _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + i))); break;
+            case FormulaOp::SUB: result = _mm_sub_epi32(a, _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + i))); break;
+            case FormulaOp::MUL: result = MultiplyLanes(a, _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + i))); break;
+            case FormulaOp::NEG: result = _mm_sub_epi32(_mm_setzero_si128(), a); break;
+            case FormulaOp::DIV:
+                // INT32_MIN has no 31 bit magnitude, the lanes holding it take the scalar path
+                if (_mm_movemask_epi8(_mm_cmpeq_epi32(a, int_min)) != 0)
+                {
+                    for (size_t lane = i; lane < i + LANES; lane++)
+                        lhs[lane] = DivideByConstant(lhs[lane], instruction);
+                    continue;
+                }
+                result = DivideLanesByConstant(a, instruction);
+                break;
+            default: return 0;
+            }
+
+            _mm_storeu_si128(lanes, result);
+        }
+
+        return i;
+    }
+#endif
+
+    /*
+    * Recursive descent over
+    *   expression = term { ("+" | "-") term }
+    *   term       = unary { ("*" | "/") unary }
+    *   unary      = "-" unary | number | name | "(" expression ")"
+    * Operations on two constants are folded, and a constant or input on the right is folded into the operation.
+    */
+    class FormulaCompiler
+    {
+    private:
+        const size_t MAX_NESTING = 32;
+
+        std::string_view m_Source;
+        size_t m_Pos, m_Depth, m_MaxDepth, m_Nesting;
+        std::vector<FormulaInstruction> m_Code;
+        uint32_t m_Inputs;
+        std::string m_sError;
+
+        bool Fail(const std::string& error)
+        {
+            if (m_sError.empty())
+                m_sError = error + " at character " + std::to_string(m_Pos);
+            return false;
+        }
+
+        void SkipSpaces()
+        {
+            while (m_Pos < m_Source.size() && std::isspace(static_cast<unsigned char>(m_Source[m_Pos])))
+                m_Pos++;
+        }
+
+        bool Match(char c)
+        {
+            SkipSpaces();
+            if (m_Pos < m_Source.size() && m_Source[m_Pos] == c)
+            {
+                m_Pos++;
+                return true;
+            }
+            return false;
+        }
+
+        static bool IsPush(const FormulaInstruction& instruction, FormulaOperand operand)
+        {
+            return instruction.op == FormulaOp::PUSH && instruction.operand == operand;
+        }
+
+        void Push(FormulaOperand operand, int32_t value)
+        {
+            m_Code.push_back({ FormulaOp::PUSH, operand, 0, value, 0 });
+            m_MaxDepth = std::max(m_MaxDepth, ++m_Depth);
+        }
+
+        bool EmitBinary(FormulaOp op)
+        {
+            const size_t size = m_Code.size();
+            m_Depth--;
+
+            FormulaInstruction& rhs = m_Code[size - 1];
+
+            if (op == FormulaOp::DIV && IsPush(rhs, FormulaOperand::CONST) && rhs.value == 0)
+                return Fail("Division by zero");
+
+            if (size >= 2 && IsPush(rhs, FormulaOperand::CONST) && IsPush(m_Code[size - 2], FormulaOperand::CONST))
+            {
+                m_Code[size - 2].value = Apply(op, m_Code[size - 2].value, rhs.value);
+                m_Code.pop_back();
+                return true;
+            }
+
+            // A right hand side that was only pushed becomes the operand, anything else is on the stack
+            if (rhs.op == FormulaOp::PUSH)
+            {
+                rhs.op = op;
+                if (op == FormulaOp::DIV && rhs.operand == FormulaOperand::CONST)
+                    SetDivisor(rhs);
+            }
+            else
+                m_Code.push_back({ op, FormulaOperand::STACK, 0, 0, 0 });
+
+            return true;
+        }
+
+        bool ParseUnary()
+        {
+            if (Match('-'))
+            {
+                if (!ParseUnary())
+                    return false;
+
+                if (IsPush(m_Code.back(), FormulaOperand::CONST))
+                    m_Code.back().value = -m_Code.back().value;
+                else
+                    m_Code.push_back({ FormulaOp::NEG, FormulaOperand::STACK, 0, 0, 0 });
+
+                return true;
+            }
+
+            if (Match('('))
+            {
+                if (++m_Nesting > MAX_NESTING)
+                    return Fail("Too many brackets");
+
+                if (!ParseExpression())
+                    return false;
+
+                m_Nesting--;
+                return Match(')') ? true : Fail("Expected ')'");
+            }
+
+            SkipSpaces();
+            const size_t start = m_Pos;
+
+            if (m_Pos < m_Source.size() && std::isdigit(static_cast<unsigned char>(m_Source[m_Pos])))
+            {
+                int64_t number = 0;
+                while (m_Pos < m_Source.size() && std::isdigit(static_cast<unsigned char>(m_Source[m_Pos])))
+                {
+                    number = number * 10 + (m_Source[m_Pos++] - '0');
+                    if (number > INT32_MAX)
+                        return Fail("Number is too large");
+                }
+
+                Push(FormulaOperand::CONST, static_cast<int32_t>(number));
+                return true;
+            }
+
+            while (m_Pos < m_Source.size() && (std::isalnum(static_cast<unsigned char>(m_Source[m_Pos])) || m_Source[m_Pos] == '_'))
+                m_Pos++;
+
+            if (start == m_Pos)
+                return Fail("Expected a number, name or '('");
+
+            const std::string_view name = m_Source.substr(start, m_Pos - start);
+            const size_t input = FindInput(name);
+
+            if (input == NUM_STAT_INPUTS)
+                return Fail("Unknown stat or slot '" + std::string{ name } + "'");
+
+            m_Inputs |= 1u << input;
+            Push(FormulaOperand::INPUT, static_cast<int32_t>(input));
+            return true;
+        }
+
+        bool ParseTerm()
+        {
+            if (!ParseUnary())
+                return false;
+
+            while (true)
+            {
+                const FormulaOp op = Match('*') ? FormulaOp::MUL : Match('/') ? FormulaOp::DIV : FormulaOp::PUSH;
+                if (op == FormulaOp::PUSH)
+                    return true;
+
+                if (!ParseUnary() || !EmitBinary(op))
+                    return false;
+            }
+        }
+
+        bool ParseExpression()
+        {
+            if (!ParseTerm())
+                return false;
+
+            while (true)
+            {
+                const FormulaOp op = Match('+') ? FormulaOp::ADD : Match('-') ? FormulaOp::SUB : FormulaOp::PUSH;
+                if (op == FormulaOp::PUSH)
+                    return true;
+
+                if (!ParseTerm() || !EmitBinary(op))
+                    return false;
+            }
+        }
+
+    public:
+        FormulaCompiler(std::string_view source)
+            : m_Source{ source }, m_Pos{ 0 }, m_Depth{ 0 }, m_MaxDepth{ 0 }, m_Nesting{ 0 }, m_Code{}, m_Inputs{ 0 }, m_sError{}
+        {
+        }
+
+        bool Compile()
+        {
+            if (!ParseExpression())
+                return false;
+
+            SkipSpaces();
+            if (m_Pos != m_Source.size())
+                return Fail("Unexpected '" + std::string(1, m_Source[m_Pos]) + "'");
+
+            if (m_MaxDepth > StatFormula::MAX_STACK)
+                return Fail("Formula is too deeply nested");
+
+            return true;
+        }
+
+        inline std::vector<FormulaInstruction>& GetCode() { return m_Code; }
+        inline const uint32_t GetInputs() const { return m_Inputs; }
+        inline const std::string& GetError() const { return m_sError; }
+    };
+}
+
+StatFormula::StatFormula()
+    : m_Code{}, m_Inputs{ 0 }, m_sSource{}
+{
+}
+
+bool StatFormula::Compile(std::string_view source)
+{
+    FormulaCompiler compiler{ source };
+
+    if (!compiler.Compile())
+    {
+        TRPG_LOGF(LogLevel::ERR, LogCategory::LOADER, "Stat formula [{}] - {}", source, compiler.GetError());
+        return false;
+    }
+
+    m_Code = std::move(compiler.GetCode());
+    m_Code.shrink_to_fit();
+    m_Inputs = compiler.GetInputs();
+    m_sSource = source;
+
+    return true;
+}
+
+int StatFormula::Evaluate(const Stats& stats) const
+{
+    const auto& slot_list = stats.GetEquipSlotList();
+
+    // Inputs are never derived stats, so reading them cannot recompute anything
+    const auto read_input = [&](int32_t input) {
+        return input < static_cast<int32_t>(NUM_STATS) ? stats.GetTotal(static_cast<StatId>(input)) : slot_list[input - NUM_STATS];
+    };
+
+    // The top of the stack is kept in a local so most instructions never touch memory,
+    // the first push spills an unused value which is why there is one extra slot
+    int stack[MAX_STACK + 1];
+    size_t top = 0;
+    int acc = 0;
+
+    // One switch over every operation and operand pair, so each instruction costs a single jump
+    for (const auto& instruction : m_Code)
+    {
+        switch (Dispatch(instruction.op, instruction.operand))
+        {
+        case Dispatch(FormulaOp::PUSH, FormulaOperand::CONST): stack[top++] = acc; acc = instruction.value; break;
+        case Dispatch(FormulaOp::PUSH, FormulaOperand::INPUT): stack[top++] = acc; acc = read_input(instruction.value); break;
+        case Dispatch(FormulaOp::ADD, FormulaOperand::CONST): acc += instruction.value; break;
+        case Dispatch(FormulaOp::ADD, FormulaOperand::INPUT): acc += read_input(instruction.value); break;
+        case Dispatch(FormulaOp::ADD, FormulaOperand::STACK): acc = stack[--top] + acc; break;
+        case Dispatch(FormulaOp::SUB, FormulaOperand::CONST): acc -= instruction.value; break;
+        case Dispatch(FormulaOp::SUB, FormulaOperand::INPUT): acc -= read_input(instruction.value); break;
+        case Dispatch(FormulaOp::SUB, FormulaOperand::STACK): acc = stack[--top] - acc; break;
+        case Dispatch(FormulaOp::MUL, FormulaOperand::CONST): acc *= instruction.value; break;
+        case Dispatch(FormulaOp::MUL, FormulaOperand::INPUT): acc *= read_input(instruction.value); break;
+        case Dispatch(FormulaOp::MUL, FormulaOperand::STACK): acc = stack[--top] * acc; break;
+        case Dispatch(FormulaOp::DIV, FormulaOperand::CONST): acc = DivideByConstant(acc, instruction); break;
+        case Dispatch(FormulaOp::DIV, FormulaOperand::INPUT): acc = Apply(FormulaOp::DIV, acc, read_input(instruction.value)); break;
+        case Dispatch(FormulaOp::DIV, FormulaOperand::STACK): acc = Apply(FormulaOp::DIV, stack[--top], acc); break;
+        case Dispatch(FormulaOp::NEG, FormulaOperand::STACK): acc = -acc; break;
+        default: break;
+        }
+    }
+
+    return acc;
+}
+
+void StatFormula::EvaluateBatch(const int* const* inputs, size_t count, int* out) const
+{
+    // Each instruction runs over a whole chunk of actors, so the dispatch is paid once per chunk
+    const size_t CHUNK = 64;
+    int stack[MAX_STACK][CHUNK];
+    int constant[CHUNK];
+
+    for (size_t start = 0; start < count; start += CHUNK)
+    {
+        const size_t n = std::min(CHUNK, count - start);
+        size_t top = 0;
+
+        for (const auto& instruction : m_Code)
+        {
+            // Inputs are read where they are, constants are spread over a chunk
+            const int* rhs = nullptr;
+
+            switch (instruction.operand)
+            {
+            case FormulaOperand::CONST:
+                std::fill_n(constant, n, instruction.value);
+                rhs = constant;
+                break;
+            case FormulaOperand::INPUT:
+                rhs = inputs[instruction.value] + start;
+                break;
+            case FormulaOperand::STACK:
+                rhs = instruction.op == FormulaOp::NEG ? nullptr : stack[--top];
+                break;
+            }
+
+            int* lhs = top > 0 ? stack[top - 1] : nullptr;
+            size_t done = 0;
+
+            if (instruction.op == FormulaOp::PUSH)
+            {
+                std::copy_n(rhs, n, stack[top++]);
+                continue;
+            }
+
+#ifdef TRPG_SIMD_SSE2
+            // Dividing by a value that is not constant has no SIMD instruction, it stays scalar
+            if (instruction.op != FormulaOp::DIV || instruction.operand == FormulaOperand::CONST)
+                done = ApplyLanes(instruction, lhs, rhs, n);
+#endif
+
+            switch (instruction.op)
+            {
+            case FormulaOp::NEG:
+                for (size_t i = done; i < n; i++)
+                    lhs[i] = -lhs[i];
+                break;
+            case FormulaOp::ADD:
+                for (size_t i = done; i < n; i++)
+                    lhs[i] += rhs[i];
+                break;
+            case FormulaOp::SUB:
+                for (size_t i = done; i < n; i++)
+                    lhs[i] -= rhs[i];
+                break;
+            case FormulaOp::MUL:
+                for (size_t i = done; i < n; i++)
+                    lhs[i] *= rhs[i];
+                break;
+            case FormulaOp::DIV:
+                if (instruction.operand == FormulaOperand::CONST)
+                {
+                    for (size_t i = done; i < n; i++)
+                        lhs[i] = DivideByConstant(lhs[i], instruction);
+                }
+                else
+                {
+                    for (size_t i = done; i < n; i++)
+                        lhs[i] = Divide(lhs[i], rhs[i]);
+                }
+                break;
+            default:
+                break;
+            }
+        }
+
+        if (top > 0)
+            std::copy_n(stack[top - 1], n, out + start);
+        else
+            std::fill_n(out + start, n, 0);
+    }
+}
+
+std::unique_ptr<StatFormulas> StatFormulas::m_pInstance = nullptr;
+
+StatFormulas::StatFormulas()
+    : m_Formulas{}, m_Dependents{}, m_DerivedStats{ 0 }
+{
+    for (const auto& formula : DEFAULT_FORMULAS)
+        m_Formulas[static_cast<size_t>(formula.stat)].Compile(formula.source);
+
+    BuildDependents();
+}
+
+StatFormulas& StatFormulas::GetInstance()
+{
+    if (!m_pInstance)
+        m_pInstance.reset(new StatFormulas());
+
+    return *m_pInstance;
+}
+
+void StatFormulas::BuildDependents()
+{
+    m_Dependents.fill(0);
+    m_DerivedStats = 0;
+
+    for (size_t stat = 0; stat < NUM_STATS; stat++)
+    {
+        const StatFormula& formula = m_Formulas[stat];
+        if (formula.IsEmpty())
+            continue;
+
+        m_DerivedStats |= 1u << stat;
+
+        for (size_t input = 0; input < NUM_STAT_INPUTS; input++)
+        {
+            if (formula.GetInputs() & (1u << input))
+                m_Dependents[input] |= 1u << stat;
+        }
+    }
+}
+
+bool StatFormulas::LoadFile(const std::string& filepath)
+{
+    TRPG_PROFILE_SCOPE("StatFormulas::LoadFile");
+
+    XMLDocument document;
+
+    if (document.LoadFile(filepath.c_str()) != XML_SUCCESS)
+    {
+        TRPG_LOGF(LogLevel::ERR, LogCategory::LOADER, "Failed to load stat formulas [{}] -- {}", filepath, document.ErrorStr());
+        return false;
+    }
+
+    XMLElement* pRootElement = document.RootElement();
+
+    if (!pRootElement)
+    {
+        TRPG_LOGF(LogLevel::ERR, LogCategory::LOADER, "Failed to get the root Element! - {}", document.ErrorStr());
+        return false;
+    }
+
+    // Every formula has to compile, otherwise the current ones are kept
+    std::array<StatFormula, NUM_STATS> formulas{};
+    uint32_t derived_stats = 0;
+
+    for (XMLElement* pFormula = pRootElement->FirstChildElement("Formula"); pFormula; pFormula = pFormula->NextSiblingElement("Formula"))
+    {
+        const char* stat_name = pFormula->Attribute("stat");
+        const char* source = pFormula->GetText();
+
+        const size_t stat = stat_name ? FindInput(stat_name) : NUM_STAT_INPUTS;
+        if (stat >= NUM_STATS || !source)
+        {
+            TRPG_LOGF(LogLevel::ERR, LogCategory::LOADER, "Invalid stat formula [{}] in [{}]", stat_name ? stat_name : "", filepath);
+            return false;
+        }
+
+        if (!formulas[stat].Compile(source))
+            return false;
+
+        derived_stats |= 1u << stat;
+    }
+
+    // Derived stats are only recomputed when their own inputs change, so they cannot read each other
+    for (size_t stat = 0; stat < NUM_STATS; stat++)
+    {
+        if (formulas[stat].GetInputs() & derived_stats)
+        {
+            TRPG_LOGF(LogLevel::ERR, LogCategory::LOADER, "Stat formula [{}] reads a derived stat", formulas[stat].GetSource());
+            return false;
+        }
+    }
+
+    m_Formulas = std::move(formulas);
+    BuildDependents();
+
+    TRPG_LOGF(LogLevel::INFO, LogCategory::LOADER, "Loaded stat formulas from [{}]", filepath);
+    return true;
+}
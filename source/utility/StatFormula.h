@@ -0,0 +1,95 @@
+#pragma once
+
+#include "../Stats.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Values a formula can read: the total of each stat, then the value of each equipment slot
+constexpr size_t NUM_STAT_INPUTS = NUM_STATS + Stats::NUM_EQUIP_SLOTS;
+
+constexpr size_t GetStatInput(StatId stat) { return static_cast<size_t>(stat); }
+constexpr size_t GetStatInput(Stats::EquipSlots slot) { return NUM_STATS + static_cast<size_t>(slot); }
+
+enum class FormulaOp : uint8_t { PUSH = 0, ADD, SUB, MUL, DIV, NEG };
+// Where the right hand value comes from, a constant or input is read directly instead of being pushed first
+enum class FormulaOperand : uint8_t { CONST = 0, INPUT, STACK };
+
+struct FormulaInstruction
+{
+    FormulaOp op;
+    FormulaOperand operand;
+    // Dividing by a constant multiplies by its reciprocal instead: (|x| * magic) >> shift
+    uint8_t shift;
+    int32_t value;
+    uint32_t magic;
+};
+
+/*
+* A formula such as "Weapon + Strength + Intelligence / 5" compiled to postfix bytecode for a small stack machine.
+* Integer maths like the C++ it replaces, dividing by zero gives zero. Evaluating never allocates.
+*/
+class StatFormula
+{
+public:
+    static const size_t MAX_STACK = 16;
+
+private:
+    std::vector<FormulaInstruction> m_Code;
+    // Bit per input the formula reads, indexed like GetStatInput
+    uint32_t m_Inputs;
+    std::string m_sSource;
+
+public:
+    StatFormula();
+    ~StatFormula() = default;
+
+    // Replaces the formula, on failure the error is logged and the formula is left unchanged
+    bool Compile(std::string_view source);
+
+    int Evaluate(const Stats& stats) const;
+    // Evaluates the formula for count actors at once, inputs[i] points to count values of input i
+    void EvaluateBatch(const int* const* inputs, size_t count, int* out) const;
+
+    inline const bool IsEmpty() const { return m_Code.empty(); }
+    inline const uint32_t GetInputs() const { return m_Inputs; }
+    inline const std::string& GetSource() const { return m_sSource; }
+    inline const std::vector<FormulaInstruction>& GetCode() const { return m_Code; }
+};
+
+/*
+* The formula of every derived stat, and which derived stats have to be recomputed when an input changes.
+* Starts with the built in formulas, LoadFile replaces them with the ones from a data file.
+*/
+class StatFormulas
+{
+private:
+    std::array<StatFormula, NUM_STATS> m_Formulas;
+    std::array<uint32_t, NUM_STAT_INPUTS> m_Dependents;
+    uint32_t m_DerivedStats;
+
+    StatFormulas();
+
+    void BuildDependents();
+
+    static std::unique_ptr<StatFormulas> m_pInstance;
+public:
+    static StatFormulas& GetInstance();
+
+    // Formulas are loaded once at startup, stats that were already computed are not updated
+    bool LoadFile(const std::string& filepath);
+
+    // nullptr for stats that are not derived
+    inline const StatFormula* Get(StatId stat) const
+    {
+        const StatFormula& formula = m_Formulas[static_cast<size_t>(stat)];
+        return formula.IsEmpty() ? nullptr : &formula;
+    }
+
+    // Bit per StatId of the derived stats that read input
+    inline const uint32_t GetDependents(size_t input) const { return m_Dependents[input]; }
+    inline const uint32_t GetDerivedStats() const { return m_DerivedStats; }
+};
@@ -0,0 +1,108 @@
+#include "StatStore.h"
+#include "../Profiler.h"
+
+StatStore::StatStore()
+    : m_Columns{}, m_DirtyStats{ 0 }, m_Count{ 0 }
+{
+}
+
+void StatStore::Reserve(size_t count)
+{
+    for (auto& column : m_Columns)
+        column.reserve(count);
+}
+
+void StatStore::Clear()
+{
+    for (auto& column : m_Columns)
+        column.clear();
+
+    m_DirtyStats = 0;
+    m_Count = 0;
+}
+
+size_t StatStore::AddActor()
+{
+    for (auto& column : m_Columns)
+        column.push_back(0);
+
+    // A new actor's derived stats have to be computed from its zeroed inputs
+    m_DirtyStats |= StatFormulas::GetInstance().GetDerivedStats();
+    return m_Count++;
+}
+
+size_t StatStore::AddActor(const Stats& stats)
+{
+    const size_t actor = AddActor();
+    SetActor(actor, stats);
+    return actor;
+}
+
+void StatStore::SetActor(size_t actor, const Stats& stats)
+{
+    const uint32_t derived = StatFormulas::GetInstance().GetDerivedStats();
+
+    for (size_t stat = 0; stat < NUM_STATS; stat++)
+    {
+        if (!(derived & (1u << stat)))
+            SetStat(actor, static_cast<StatId>(stat), stats.GetTotal(static_cast<StatId>(stat)));
+    }
+
+    for (size_t slot = 0; slot < Stats::NUM_EQUIP_SLOTS; slot++)
+        SetEquipmentValue(actor, static_cast<Stats::EquipSlots>(slot), stats.GetEquipmentValue(static_cast<Stats::EquipSlots>(slot)));
+}
+
+void StatStore::RemoveActor(size_t actor)
+{
+    for (auto& column : m_Columns)
+    {
+        column[actor] = column.back();
+        column.pop_back();
+    }
+
+    m_Count--;
+}
+
+void StatStore::SetInput(size_t input, size_t actor, int value)
+{
+    int& current = m_Columns[input][actor];
+    if (current == value)
+        return;
+
+    current = value;
+    m_DirtyStats |= StatFormulas::GetInstance().GetDependents(input);
+}
+
+void StatStore::SetStat(size_t actor, StatId stat, int value)
+{
+    SetInput(GetStatInput(stat), actor, value);
+}
+
+void StatStore::SetEquipmentValue(size_t actor, Stats::EquipSlots slot, int value)
+{
+    SetInput(GetStatInput(slot), actor, value);
+}
+
+void StatStore::UpdateStats() const
+{
+    const StatFormulas& formulas = StatFormulas::GetInstance();
+    const uint32_t dirty = m_DirtyStats & formulas.GetDerivedStats();
+
+    if (dirty == 0)
+        return;
+
+    TRPG_PROFILE_SCOPE("StatStore::UpdateStats");
+
+    // Formulas never read a derived stat, so every input column is final before any output is written
+    std::array<const int*, NUM_STAT_INPUTS> inputs;
+    for (size_t input = 0; input < NUM_STAT_INPUTS; input++)
+        inputs[input] = m_Columns[input].data();
+
+    for (size_t stat = 0; stat < NUM_STATS; stat++)
+    {
+        if (dirty & (1u << stat))
+            formulas.Get(static_cast<StatId>(stat))->EvaluateBatch(inputs.data(), m_Count, m_Columns[stat].data());
+    }
+
+    m_DirtyStats &= ~dirty;
+}
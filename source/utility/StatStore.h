@@ -0,0 +1,58 @@
+#pragma once
+
+#include "StatFormula.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/*
+* The stats of many actors (a party, an enemy wave) kept as one contiguous column per stat and equipment slot.
+* Derived stats are computed for every actor at once by the formulas' batch kernels, and like Stats only the
+* derived stats whose inputs changed are recomputed, the next time one is read.
+* Base stats are stored as totals, with their modifiers already applied.
+*/
+class StatStore
+{
+private:
+    // Indexed like GetStatInput, the columns of derived stats hold their computed values
+    mutable std::array<std::vector<int>, NUM_STAT_INPUTS> m_Columns;
+    mutable uint32_t m_DirtyStats;
+    size_t m_Count;
+
+    void SetInput(size_t input, size_t actor, int value);
+
+public:
+    StatStore();
+    ~StatStore() = default;
+
+    void Reserve(size_t count);
+    void Clear();
+
+    // Returns the index of the new actor, its stats start at zero
+    size_t AddActor();
+    // Copies the totals and equipment values of stats
+    size_t AddActor(const Stats& stats);
+    void SetActor(size_t actor, const Stats& stats);
+    // The last actor takes the removed one's index
+    void RemoveActor(size_t actor);
+
+    void SetStat(size_t actor, StatId stat, int value);
+    void SetEquipmentValue(size_t actor, Stats::EquipSlots slot, int value);
+
+    inline const int GetStat(size_t actor, StatId stat) const
+    {
+        if (m_DirtyStats & (1u << static_cast<uint32_t>(stat)))
+            UpdateStats();
+
+        return m_Columns[GetStatInput(stat)][actor];
+    }
+    inline const int GetEquipmentValue(size_t actor, Stats::EquipSlots slot) const { return m_Columns[GetStatInput(slot)][actor]; }
+
+    // Count values, one per actor
+    inline const int* GetColumn(StatId stat) const { UpdateStats(); return m_Columns[GetStatInput(stat)].data(); }
+    inline const int* GetColumn(Stats::EquipSlots slot) const { return m_Columns[GetStatInput(slot)].data(); }
+    inline const size_t GetCount() const { return m_Count; }
+
+    // Recomputes every dirty derived stat for all actors
+    void UpdateStats() const;
+};
@@ -0,0 +1,28 @@
+#include "StringTable.h"
+
+std::unique_ptr<StringTable> StringTable::m_pInstance = nullptr;
+
+StringTable::StringTable()
+    : m_Strings{}, m_Index{}
+{
+    Intern(L"");
+}
+
+StringTable& StringTable::GetInstance()
+{
+    if (!m_pInstance)
+        m_pInstance.reset(new StringTable());
+
+    return *m_pInstance;
+}
+
+uint32_t StringTable::Intern(std::wstring_view str)
+{
+    if (auto it = m_Index.find(str); it != m_Index.end())
+        return it->second;
+
+    const uint32_t id = static_cast<uint32_t>(m_Strings.size());
+    const std::wstring& stored = m_Strings.emplace_back(str);
+    m_Index.emplace(stored, id);
+    return id;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/*
+* Every distinct name and ID is stored once, instances keep a 32 bit handle to it.
+* Strings are interned when they are loaded, after that comparing and hashing names is an integer operation.
+* The table is only used from the game thread.
+*/
+class StringTable
+{
+private:
+    // A deque never moves its elements, so the views used as keys stay valid
+    std::deque<std::wstring> m_Strings;
+    std::unordered_map<std::wstring_view, uint32_t> m_Index;
+
+    static std::unique_ptr<StringTable> m_pInstance;
+
+    StringTable();
+
+public:
+    static StringTable& GetInstance();
+
+    // Returns the handle of the string, adding it the first time it is seen
+    uint32_t Intern(std::wstring_view str);
+    inline const std::wstring& Get(uint32_t id) const { return m_Strings[id]; }
+    inline const size_t Size() const { return m_Strings.size(); }
+};
+
+// Handle to an interned string, two handles are equal when their strings are
+class InternedString
+{
+private:
+    // 0 is the empty string
+    uint32_t m_Id;
+
+public:
+    constexpr InternedString() : m_Id{ 0 } {}
+    InternedString(std::wstring_view str) : m_Id{ StringTable::GetInstance().Intern(str) } {}
+    InternedString(const std::wstring& str) : InternedString(std::wstring_view{ str }) {}
+    InternedString(const wchar_t* str) : InternedString(std::wstring_view{ str }) {}
+
+    inline const std::wstring& Get() const { return StringTable::GetInstance().Get(m_Id); }
+    inline const uint32_t GetId() const { return m_Id; }
+    inline const bool IsEmpty() const { return m_Id == 0; }
+
+    bool operator==(const InternedString& other) const = default;
+};
+
+template <>
+struct std::hash<InternedString>
+{
+    size_t operator()(const InternedString& str) const noexcept { return std::hash<uint32_t>{}(str.GetId()); }
+};
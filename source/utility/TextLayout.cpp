@@ -0,0 +1,111 @@
+#include "TextLayout.h"
+#include <algorithm>
+
+void TextLayout::Layout()
+{
+    m_Lines.clear();
+    m_NumChars = 0;
+
+    const size_t width = static_cast<size_t>(std::max(m_Width, 1));
+    const size_t size = m_sText.size();
+
+    auto add_line = [&](size_t first, size_t last) {
+        while (last > first && m_sText[last - 1] == L' ')
+            last--;
+
+        m_Lines.push_back(TextLine{ static_cast<uint32_t>(first), static_cast<uint32_t>(last - first) });
+        m_NumChars += last - first;
+        };
+
+    size_t start = 0;
+    // One past the last place the current line may break, std::wstring::npos when there is none
+    size_t last_break = std::wstring::npos;
+    size_t i = 0;
+
+    while (i < size)
+    {
+        const wchar_t character = m_sText[i];
+
+        if (character == L'\n')
+        {
+            add_line(start, i);
+            start = i + 1;
+            last_break = std::wstring::npos;
+            i++;
+            continue;
+        }
+
+        if (i - start >= width)
+        {
+            // Break at the space itself, after the last break opportunity, or mid word if there was none
+            size_t line_end = i;
+            if (character != L' ' && last_break != std::wstring::npos && last_break > start)
+                line_end = last_break;
+
+            add_line(start, line_end);
+            start = line_end;
+
+            while (start < size && m_sText[start] == L' ')
+                start++;
+
+            // Nothing after last_break could break, so the carried over characters are not checked again
+            last_break = std::wstring::npos;
+            i = std::max(i, start);
+            continue;
+        }
+
+        if (character == L' ' || character == L'!' || character == L'?')
+            last_break = i + 1;
+
+        i++;
+    }
+
+    if (start < size)
+        add_line(start, size);
+}
+
+TextLayout::TextLayout(const std::wstring& text, int width)
+    : m_sText{ text }, m_Lines{}, m_Width{ width }, m_NumChars{ 0 }
+{
+    Layout();
+}
+
+std::wstring_view TextLayout::GetLine(size_t index) const
+{
+    if (index >= m_Lines.size())
+        return std::wstring_view{};
+
+    const auto& line = m_Lines[index];
+    return std::wstring_view{ m_sText }.substr(line.offset, line.length);
+}
+
+std::unique_ptr<TextLayoutCache> TextLayoutCache::m_pInstance = nullptr;
+
+TextLayoutCache::TextLayoutCache()
+    : m_Layouts{}
+{
+}
+
+TextLayoutCache& TextLayoutCache::GetInstance()
+{
+    if (!m_pInstance)
+        m_pInstance.reset(new TextLayoutCache());
+
+    return *m_pInstance;
+}
+
+std::shared_ptr<const TextLayout> TextLayoutCache::Get(const std::wstring& text, int width)
+{
+    auto it = m_Layouts.find(LayoutKey{ text, width });
+    if (it != m_Layouts.end())
+        return it->second;
+
+    // Layouts in use stay alive through their shared_ptr, so dropping the cache is safe
+    if (m_Layouts.size() >= MAX_LAYOUTS)
+        m_Layouts.clear();
+
+    auto layout = std::make_shared<const TextLayout>(text, width);
+    m_Layouts.emplace(LayoutKey{ layout->GetText(), width }, layout);
+
+    return layout;
+}
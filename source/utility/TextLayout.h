@@ -0,0 +1,78 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <cstdint>
+
+struct TextLine
+{
+    uint32_t offset, length;
+};
+
+/*
+* Word wrapped text stored as a table of line offsets into a single copy of the text.
+* Lines break after a space, '!' or '?' and on '\n', words longer than the width are split.
+*/
+class TextLayout
+{
+private:
+    std::wstring m_sText;
+    std::vector<TextLine> m_Lines;
+    int m_Width;
+    size_t m_NumChars;
+
+    void Layout();
+
+public:
+    TextLayout(const std::wstring& text, int width);
+    ~TextLayout() = default;
+
+    inline const std::wstring& GetText() const { return m_sText; }
+    inline const std::vector<TextLine>& GetLines() const { return m_Lines; }
+    inline const size_t GetNumLines() const { return m_Lines.size(); }
+    inline const int GetWidth() const { return m_Width; }
+    // Number of characters shown across all of the lines
+    inline const size_t GetNumChars() const { return m_NumChars; }
+
+    std::wstring_view GetLine(size_t index) const;
+};
+
+/*
+* Layouts shared by (text, width), so text that is shown again is not wrapped again.
+*/
+class TextLayoutCache
+{
+private:
+    struct LayoutKey
+    {
+        std::wstring_view text;
+        int width;
+
+        bool operator==(const LayoutKey& other) const { return width == other.width && text == other.text; }
+    };
+
+    struct LayoutKeyHash
+    {
+        size_t operator()(const LayoutKey& key) const
+        {
+            return std::hash<std::wstring_view>{}(key.text) ^ (static_cast<size_t>(key.width) * 0x9E3779B97F4A7C15ull);
+        }
+    };
+
+    const size_t MAX_LAYOUTS = 512;
+
+    // Keys view the text owned by their layout
+    std::unordered_map<LayoutKey, std::shared_ptr<const TextLayout>, LayoutKeyHash> m_Layouts;
+
+    TextLayoutCache();
+
+    static std::unique_ptr<TextLayoutCache> m_pInstance;
+public:
+    static TextLayoutCache& GetInstance();
+
+    std::shared_ptr<const TextLayout> Get(const std::wstring& text, int width);
+    void Clear() { m_Layouts.clear(); }
+};
@@ -9,7 +9,7 @@ bool Typewriter::SetBorderProperties()
     m_BorderY = std::clamp(m_y - 2, 0, 47);
 
     m_BorderWidth = m_TextWrap + 2;
-    m_BorderHeight = static_cast<int>(m_sTextChunks.size()) + 2;
+    m_BorderHeight = static_cast<int>(m_pLayout->GetNumLines()) + 2;
 
     if (m_BorderHeight <= 2 || m_BorderWidth <= 2)
     {
@@ -48,58 +48,47 @@ Typewriter::Typewriter(Console& console)
 }
 
 Typewriter::Typewriter(Console& console, int start_x, int start_y, const std::wstring& text, int text_wrap, int speed, WORD textColour, WORD borderColour)
-    : m_Console(console), m_sText(text), m_sCurrentText(L""),
-    m_x(start_x), m_y(start_y), m_BorderX(0), m_BorderY(0), m_BorderWidth(0), m_BorderHeight(0),
-    m_TextSpeed(speed), m_TextWrap(text_wrap), m_CharIndex(0), m_TextIndex(0), m_Index(0), // Initialize m_Index
-    m_TextColour(textColour), m_BorderColour(borderColour), m_Timer(), m_bFinished(false)
+    : Typewriter(console, start_x, start_y, TextLayoutCache::GetInstance().Get(text, text_wrap), speed, textColour, borderColour)
 {
-    if (!SetText(text))
+}
+
+Typewriter::Typewriter(Console& console, int start_x, int start_y, std::shared_ptr<const TextLayout> layout, int speed, WORD textColour, WORD borderColour)
+    : m_Console(console),
+    m_x(start_x), m_y(start_y), m_BorderX(0), m_BorderWidth(0), m_BorderHeight(0),
+    m_TextSpeed(speed), m_TextWrap(0), m_BorderY(0), m_NumRevealed(0), m_NumDrawn(0),
+    m_TextColour(textColour), m_BorderColour(borderColour), m_Timer(TimeDomain::GAME), m_bFinished(false),
+    m_RevealMode(RevealMode::CHARACTER), m_pLayout(nullptr)
+{
+    if (!SetLayout(layout))
     {
         TRPG_ERROR("Failed to initialise text!");
         return;
     }
 
     ClearArea();
-    m_Timer.Start();
 }
 
 
 
 bool Typewriter::SetText(const std::wstring& text)
 {
-    m_sText = text;
-    m_sTextChunks.clear();
-
-    std::wstring text_holder;
+    return SetLayout(TextLayoutCache::GetInstance().Get(text, m_TextWrap));
+}
 
-    for (size_t i = 0; i < text.size(); i++)
+bool Typewriter::SetLayout(std::shared_ptr<const TextLayout> layout)
+{
+    if (!layout)
     {
-        text_holder += text[i];
-        bool newLine = text[i] == '\n';
-
-        if (text_holder.size() >= static_cast<size_t>(m_TextWrap) || newLine)
-        {
-            if (!newLine)
-            {
-                while (i > 0 && text[i] != ' ' && text[i] != '!' && text[i] != '?')
-                {
-                    i--;
-                    if (!text_holder.empty()) text_holder.pop_back();
-                }
-            }
-
-            if (!text_holder.empty())
-            {
-                m_sTextChunks.push_back(text_holder);
-                text_holder.clear();
-            }
-        }
+        TRPG_ERROR("Typewriter layout is null!");
+        return false;
     }
 
-    if (!text_holder.empty())
-    {
-        m_sTextChunks.push_back(text_holder);
-    }
+    // Remove the previous text, the new one can be smaller
+    if (m_pLayout)
+        ClearArea();
+
+    m_pLayout = std::move(layout);
+    m_TextWrap = m_pLayout->GetWidth();
 
     if (!SetBorderProperties())
     {
@@ -107,37 +96,39 @@ bool Typewriter::SetText(const std::wstring& text)
         return false;
     }
 
-    m_CharIndex = 0;
-    m_TextIndex = 0;
+    m_NumRevealed = 0;
+    m_NumDrawn = 0;
     m_bFinished = false;
-    m_sCurrentText.clear();
+
+    // The reveal is timed from when the text was set
+    m_Timer.Stop();
+    m_Timer.Start();
 
     return true;
 }
 
+void Typewriter::Skip()
+{
+    if (m_pLayout)
+        m_NumRevealed = m_pLayout->GetNumChars();
+}
+
 void Typewriter::UpdateText()
 {
     if (!m_Timer.IsRunning() || m_bFinished)
         return;
 
-    if (m_Timer.ElapsedMS() > m_TextSpeed * m_Index &&
-        m_TextIndex < m_sTextChunks.size() &&
-        m_Index < m_sText.size())
-    {
-        m_sCurrentText += m_sTextChunks[m_TextIndex][m_CharIndex++];
+    const size_t num_chars = m_pLayout->GetNumChars();
 
-        if (m_CharIndex >= m_sTextChunks[m_TextIndex].size())
-        {
-            m_CharIndex = 0;
-            m_TextIndex++;
-            m_y++;
-            m_sCurrentText.clear();
-        }
+    // Everything that is due by now is revealed at once, so speeds shorter than a frame still hold
+    size_t num_due = num_chars;
+    if (m_RevealMode == RevealMode::CHARACTER && m_TextSpeed > 0)
+        num_due = static_cast<size_t>(m_Timer.ElapsedMS() / m_TextSpeed);
 
-        m_Index++;
-    }
+    m_NumRevealed = std::clamp(num_due, m_NumRevealed, num_chars);
 
-    if (m_Index >= m_sText.size() + 1)
+    // Finish once the whole text has been drawn
+    if (m_NumDrawn >= num_chars)
     {
         m_Timer.Stop();
         m_bFinished = true;
@@ -149,7 +140,18 @@ void Typewriter::Draw(bool showBorder)
 {
     if (!m_bFinished)
     {
-        m_Console.Write(m_x, m_y, m_sCurrentText, m_TextColour);
+        size_t remaining = m_NumRevealed;
+
+        for (size_t i = 0; i < m_pLayout->GetNumLines() && remaining > 0; i++)
+        {
+            const auto line = m_pLayout->GetLine(i);
+            const size_t count = std::min(remaining, line.size());
+
+            m_Console.Write(m_x, m_y + static_cast<int>(i), line.substr(0, count), m_TextColour);
+            remaining -= count;
+        }
+
+        m_NumDrawn = m_NumRevealed;
 
         if (showBorder)
             DrawBorder();
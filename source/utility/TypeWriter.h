@@ -5,21 +5,27 @@
 #include <vector>
 #include "timer.h"
 #include "Colours.h"
+#include "TextLayout.h"
 
 class Console;
 
 class Typewriter
 {
+public:
+    // CHARACTER reveals the text at the text speed, PAGE shows the whole page at once
+    enum class RevealMode { CHARACTER = 0, PAGE };
+
 private:
     Console& m_Console;
-    std::wstring m_sText, m_sCurrentText;
     int m_x, m_y, m_BorderX, m_BorderWidth, m_BorderHeight;
-    int m_TextSpeed, m_TextWrap, m_CharIndex, m_TextIndex, m_BorderY, m_Index;
+    int m_TextSpeed, m_TextWrap, m_BorderY;
+    size_t m_NumRevealed, m_NumDrawn;
     WORD m_TextColour, m_BorderColour;
     Timer m_Timer;
     bool m_bFinished;
+    RevealMode m_RevealMode;
 
-    std::vector<std::wstring> m_sTextChunks;
+    std::shared_ptr<const TextLayout> m_pLayout;
 
     bool SetBorderProperties();
     void DrawBorder();
@@ -28,10 +34,17 @@ private:
 public:
     Typewriter(Console& console);
     Typewriter(Console& console, int start_x, int start_y, const std::wstring& text, int text_wrap, int speed, WORD textColour = WHITE, WORD borderColour = WHITE);
+    Typewriter(Console& console, int start_x, int start_y, std::shared_ptr<const TextLayout> layout, int speed, WORD textColour = WHITE, WORD borderColour = WHITE);
 
     bool SetText(const std::wstring& text);
+    // Shows text that is already laid out, the text wrap becomes the width of the layout
+    bool SetLayout(std::shared_ptr<const TextLayout> layout);
     inline void SetBorderColour(WORD colour) { m_BorderColour = colour; }
+    inline void SetRevealMode(RevealMode mode) { m_RevealMode = mode; }
+    inline const RevealMode GetRevealMode() const { return m_RevealMode; }
 
+    // Reveals the rest of the text on the next update
+    void Skip();
     void UpdateText();
     void Draw(bool showBorder = true);
     inline const bool IsFinished() const { return m_bFinished; }
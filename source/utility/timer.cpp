@@ -1,7 +1,7 @@
 #include "timer.h"
 
-Timer::Timer()
-	: m_bIsRunning{ false }, m_bIsPaused{ false }
+Timer::Timer(TimeDomain domain)
+	: m_StartPoint{ 0 }, m_PausedPoint{ 0 }, m_bIsRunning{ false }, m_bIsPaused{ false }, m_Domain{ domain }
 {
 	
 }
@@ -10,7 +10,7 @@ void Timer::Start()
 {
 	if (!m_bIsRunning)
 	{
-		m_StartPoint = steady_clock::now();
+		m_StartPoint = Clock::GetInstance().Now(m_Domain);
 		m_bIsRunning = true;
 		m_bIsPaused = false;
 	}
@@ -27,7 +27,7 @@ void Timer::Pause()
 	if (m_bIsRunning && !m_bIsPaused)
 	{
 		m_bIsPaused = true;
-		m_PausedPoint = steady_clock::now();
+		m_PausedPoint = Clock::GetInstance().Now(m_Domain);
 	}
 }
 
@@ -36,7 +36,7 @@ void Timer::Resume()
 	if (m_bIsRunning && m_bIsPaused)
 	{
 		m_bIsPaused = false;
-		m_StartPoint += duration_cast<milliseconds>(steady_clock::now() - m_PausedPoint);
+		m_StartPoint += Clock::GetInstance().Now(m_Domain) - m_PausedPoint;
 	}
 }
 
@@ -45,9 +45,9 @@ const int64_t Timer::ElapsedMS()
 	if (m_bIsRunning)
 	{
 		if (m_bIsPaused)
-			return duration_cast<milliseconds>(m_PausedPoint - m_StartPoint).count();
+			return m_PausedPoint - m_StartPoint;
 		else
-			return duration_cast<milliseconds>(steady_clock::now() - m_StartPoint).count();
+			return Clock::GetInstance().Now(m_Domain) - m_StartPoint;
 	}
 	return 0;
 }
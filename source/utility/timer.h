@@ -1,17 +1,20 @@
 #pragma once
 
 #include <chrono>
+#include "Clock.h"
 
 using namespace std::chrono;
 
 class Timer
 {
 private:
-    time_point<steady_clock> m_StartPoint, m_PausedPoint;
+    // Times read from the Clock, in milliseconds
+    int64_t m_StartPoint, m_PausedPoint;
     bool m_bIsRunning, m_bIsPaused;
+    TimeDomain m_Domain;
 
 public:
-    Timer();
+    Timer(TimeDomain domain = TimeDomain::REAL);
     ~Timer() = default;
 
     void Start();
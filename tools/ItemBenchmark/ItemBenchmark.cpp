@@ -0,0 +1,144 @@
+/*
+* Counts the allocations made loading a large weapon shop, and creating its items on their own.
+* Build from the repository root:
+*   cl /std:c++20 /EHsc /O2 /DNOMINMAX /Ilibs\tinyxml2 tools\ItemBenchmark\ItemBenchmark.cpp source\Actor.cpp source\Equipment.cpp
+*      source\Inventory.cpp source\Logger.cpp source\Player.cpp source\Potion.cpp source\Profiler.cpp source\Stats.cpp
+*      source\ecs\World.cpp source\utility\ItemCatalog.cpp source\utility\ItemPool.cpp source\utility\ShopLoader.cpp
+*      source\utility\StringTable.cpp source\utility\StatFormula.cpp source\utility\trpg_utilities.cpp
+*      source\utility\AllocationCounter.cpp libs\tinyxml2\tinyxml2.cpp
+* Add /DTRPG_NO_ITEM_POOL to compare against std::make_shared.
+* Usage: ItemBenchmark [num_items], 10000 by default
+*/
+#include "../../source/Inventory.h"
+#include "../../source/utility/AllocationCounter.h"
+#include "../../source/utility/ItemCatalog.h"
+#include "../../source/utility/ShopLoader.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const std::string SHOP_FILE = "ItemBenchmarkShop.xml";
+
+    std::wstring GetWeaponName(size_t index)
+    {
+        return L"Benchmark Sword " + std::to_wstring(index);
+    }
+
+    // One definition per shop entry, so the shop can not stack them
+    void RegisterWeapons(size_t num_items)
+    {
+        ItemCatalog& catalog = ItemCatalog::GetInstance();
+
+        for (size_t i = 0; i < num_items; i++)
+        {
+            Equipment::Definition definition{
+                .name = GetWeaponName(i), .description = L"A sword made to be counted",
+                .type = Equipment::EquipType::WEAPON, .buyPrice = 100, .sellPrice = 50
+            };
+            definition.properties.weapon = WeaponProperties(10, WeaponProperties::WeaponType::SWORD);
+            catalog.AddEquipment(std::move(definition));
+        }
+    }
+
+    bool WriteShopFile(size_t num_items)
+    {
+        std::ofstream file{ SHOP_FILE };
+        if (!file)
+            return false;
+
+        file << "<WeaponShop>\n\t<ShopParameters>\n\t\t<ShopType>Weapon</ShopType>\n\t\t<Inventory>\n\t\t\t<ShopItem>\n";
+        for (size_t i = 0; i < num_items; i++)
+            file << "\t\t\t\t<Weapon><Name>Benchmark Sword " << i << "</Name></Weapon>\n";
+        file << "\t\t\t</ShopItem>\n\t\t</Inventory>\n\t</ShopParameters>\n</WeaponShop>\n";
+
+        return static_cast<bool>(file);
+    }
+
+    struct Measurement
+    {
+        uint64_t allocations;
+        double milliseconds;
+    };
+
+    template <typename Fn>
+    Measurement Measure(Fn&& fn)
+    {
+        const uint64_t allocations = GetAllocationCount();
+        const auto start = std::chrono::steady_clock::now();
+
+        fn();
+
+        const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return { GetAllocationCount() - allocations, elapsed };
+    }
+
+    void Print(const char* label, const Measurement& measurement, size_t num_items)
+    {
+        std::cout << "  " << label << measurement.allocations << " allocations ("
+            << static_cast<double>(measurement.allocations) / num_items << " per item), "
+            << measurement.milliseconds << " ms\n";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t num_items = argc > 1 ? std::max<size_t>(1, std::strtoul(argv[1], nullptr, 10)) : 10000;
+
+    RegisterWeapons(num_items);
+
+    if (!WriteShopFile(num_items))
+    {
+        std::cerr << "Failed to write " << SHOP_FILE << "\n";
+        return 1;
+    }
+
+    ShopLoader loader;
+    std::unique_ptr<ShopParameters> shop;
+    size_t shop_size = 0;
+
+    // The first load also creates the pools' slabs, the second reuses the blocks the first one freed
+    const Measurement first_load = Measure([&] { shop = loader.CreateShopParametersFromFile(SHOP_FILE); });
+    shop_size = shop ? shop->inventory->GetEquipment().size() : 0;
+    shop.reset();
+
+    const Measurement second_load = Measure([&] { shop = loader.CreateShopParametersFromFile(SHOP_FILE); });
+    shop.reset();
+
+    // Only the items, without the XML parsing and the inventory's own storage
+    ItemCatalog& catalog = ItemCatalog::GetInstance();
+    std::vector<std::shared_ptr<Equipment>> items;
+    items.reserve(num_items);
+
+    const Measurement create = Measure([&] {
+        for (size_t i = 1; i <= num_items; i++)
+            items.push_back(catalog.CreateEquipment(*catalog.GetEquipment(static_cast<uint32_t>(i))));
+    });
+    const Measurement destroy = Measure([&] { items.clear(); });
+
+    std::remove(SHOP_FILE.c_str());
+
+#ifdef TRPG_NO_ITEM_POOL
+    std::cout << num_items << " item shop, std::make_shared\n";
+#else
+    std::cout << num_items << " item shop, pooled\n";
+#endif
+    Print("first load    ", first_load, num_items);
+    Print("second load   ", second_load, num_items);
+    Print("create items  ", create, num_items);
+    Print("destroy items ", destroy, num_items);
+
+    if (shop_size != num_items)
+    {
+        std::cerr << "The shop has " << shop_size << " items, expected " << num_items << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,202 @@
+/*
+* Turns a binary log written by a TRPG_BINARY_LOG build (trpg.bin) into the same text as trpg.log.
+* Build: cl /std:c++20 /EHsc /O2 LogDecoder.cpp
+* Usage: LogDecoder trpg.bin [trpg.txt]
+*/
+#define _CRT_SECURE_NO_WARNINGS
+
+#include "../../source/utility/LogFormat.h"
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    struct Site
+    {
+        uint8_t level, category;
+        uint32_t line;
+        std::string format, file, function;
+    };
+
+    class Reader
+    {
+    private:
+        const std::vector<char>& m_Data;
+        size_t m_Pos;
+
+    public:
+        Reader(const std::vector<char>& data, size_t pos) : m_Data{ data }, m_Pos{ pos } {}
+
+        inline const bool IsDone() const { return m_Pos >= m_Data.size(); }
+        inline const size_t GetPos() const { return m_Pos; }
+
+        template <typename T>
+        bool Read(T& value)
+        {
+            if (m_Pos + sizeof(T) > m_Data.size())
+                return false;
+
+            std::memcpy(&value, m_Data.data() + m_Pos, sizeof(T));
+            m_Pos += sizeof(T);
+            return true;
+        }
+
+        bool ReadBytes(size_t size, const char*& bytes)
+        {
+            if (m_Pos + size > m_Data.size())
+                return false;
+
+            bytes = m_Data.data() + m_Pos;
+            m_Pos += size;
+            return true;
+        }
+
+        bool ReadString(std::string& text)
+        {
+            uint16_t size = 0;
+            const char* bytes = nullptr;
+
+            if (!Read(size) || !ReadBytes(size, bytes))
+                return false;
+
+            text.assign(bytes, size);
+            return true;
+        }
+    };
+
+    void AppendMessage(std::string& out, const Site& site, int64_t time_ms, const char* payload, size_t length)
+    {
+        const std::time_t time = static_cast<std::time_t>(time_ms / 1000);
+        char time_text[32];
+        std::strftime(time_text, sizeof(time_text), "%y-%m-%d %H:%M:%S", std::localtime(&time));
+
+        const char* level = site.level < std::size(LOG_LEVEL_NAMES) ? LOG_LEVEL_NAMES[site.level] : "?";
+
+        char prefix[96];
+        const int prefix_length = site.category == 0
+            ? std::snprintf(prefix, sizeof(prefix), "%s: %s.%03d - ", level, time_text, static_cast<int>(time_ms % 1000))
+            : std::snprintf(prefix, sizeof(prefix), "%s: %s.%03d - [%s] ", level, time_text, static_cast<int>(time_ms % 1000),
+                site.category < std::size(LOG_CATEGORY_NAMES) ? LOG_CATEGORY_NAMES[site.category] : "?");
+
+        out.append(prefix, prefix_length > 0 ? prefix_length : 0);
+        FormatLogMessage(out, site.format, payload, length);
+        out += '\n';
+
+        // Matches the location block the text log writes for errors
+        if (site.level == 3 && site.line > 0)
+            out += "FILE: " + site.file + "\nFUNC: " + site.function + "\nLINE: " + std::to_string(site.line) + "\n";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <trpg.bin> [output.txt]\n";
+        return 1;
+    }
+
+    std::ifstream in{ argv[1], std::ios::binary };
+    if (!in.is_open())
+    {
+        std::cerr << "Failed to open [" << argv[1] << "]\n";
+        return 1;
+    }
+
+    const std::vector<char> data{ std::istreambuf_iterator<char>{ in }, std::istreambuf_iterator<char>{} };
+
+    if (data.size() < sizeof(LOG_BINARY_MAGIC) || std::memcmp(data.data(), LOG_BINARY_MAGIC, sizeof(LOG_BINARY_MAGIC)) != 0)
+    {
+        std::cerr << "[" << argv[1] << "] is not a binary log\n";
+        return 1;
+    }
+
+    std::unordered_map<uint32_t, Site> sites;
+    std::string out;
+    out.reserve(data.size() * 4);
+
+    Reader reader{ data, sizeof(LOG_BINARY_MAGIC) };
+    uint64_t num_messages = 0;
+
+    while (!reader.IsDone())
+    {
+        const size_t entry_pos = reader.GetPos();
+        uint8_t entry = 0;
+        reader.Read(entry);
+
+        bool ok = true;
+
+        switch (static_cast<LogEntry>(entry))
+        {
+        case LogEntry::SITE:
+        {
+            uint32_t id = 0;
+            Site site{};
+            ok = reader.Read(id) && reader.Read(site.level) && reader.Read(site.category) && reader.Read(site.line) &&
+                reader.ReadString(site.format) && reader.ReadString(site.file) && reader.ReadString(site.function);
+
+            if (ok)
+                sites[id] = std::move(site);
+            break;
+        }
+        case LogEntry::MESSAGE:
+        {
+            uint32_t id = 0;
+            int64_t time_ms = 0;
+            uint16_t length = 0;
+            const char* payload = nullptr;
+            ok = reader.Read(id) && reader.Read(time_ms) && reader.Read(length) && reader.ReadBytes(length, payload);
+
+            if (!ok)
+                break;
+
+            const auto site = sites.find(id);
+            if (site == sites.end())
+            {
+                std::cerr << "Message at offset " << entry_pos << " uses unknown site " << id << "\n";
+                break;
+            }
+
+            AppendMessage(out, site->second, time_ms, payload, length);
+            num_messages++;
+            break;
+        }
+        case LogEntry::DROPPED:
+        {
+            uint64_t dropped = 0;
+            ok = reader.Read(dropped);
+
+            if (ok)
+                out += "LOG: " + std::to_string(dropped) + " messages were dropped, the log queue was full\n";
+            break;
+        }
+        default:
+            ok = false;
+            break;
+        }
+
+        // A log cut off by a crash ends mid entry, keep what was decoded before it
+        if (!ok)
+        {
+            std::cerr << "Stopped at offset " << entry_pos << ", the rest of the log is incomplete\n";
+            break;
+        }
+    }
+
+    if (argc > 2)
+    {
+        std::ofstream file{ argv[2], std::ios::binary };
+        file.write(out.data(), out.size());
+    }
+    else
+        std::cout << out;
+
+    std::cerr << "Decoded " << num_messages << " messages from " << sites.size() << " call sites\n";
+    return 0;
+}
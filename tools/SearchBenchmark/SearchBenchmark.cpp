@@ -0,0 +1,136 @@
+/*
+* Times each keystroke of the Selector's type-to-filter search over a large list of names,
+* against the target of under 1 ms per keystroke, and checks the matches against a plain search.
+* Build from the repository root:
+*   cl /std:c++20 /EHsc /O2 tools\SearchBenchmark\SearchBenchmark.cpp source\utility\SearchIndex.cpp
+*      source\utility\AllocationCounter.cpp
+* Usage: SearchBenchmark [num_names], 10000 by default
+*/
+#include "../../source/utility/AllocationCounter.h"
+#include "../../source/utility/SearchIndex.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cwctype>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const double TARGET_MS = 1.0;
+    const int REPEATS = 200;
+
+    // Typed one character at a time, then taken back with backspace
+    const std::vector<std::wstring> QUERIES{ L"s", L"sword", L"iron s", L"ring of", L"e", L"zzz" };
+
+    std::vector<std::wstring> CreateNames(size_t num_names)
+    {
+        const std::vector<std::wstring> materials{ L"Iron", L"Steel", L"Silver", L"Mythril", L"Bone", L"Oak", L"Crystal", L"Ancient" };
+        const std::vector<std::wstring> items{ L"Sword", L"Shield", L"Helm", L"Boots", L"Ring of Speed", L"Axe", L"Potion", L"Ether" };
+
+        std::mt19937 random{ 1234 };
+        std::vector<std::wstring> names;
+        names.reserve(num_names);
+
+        for (size_t i = 0; i < num_names; i++)
+            names.push_back(materials[random() % materials.size()] + L" " + items[random() % items.size()] + L" " + std::to_wstring(i));
+
+        return names;
+    }
+
+    // Prefix matches first, then the rest, each in list order, the same as the index
+    std::vector<size_t> PlainSearch(const std::vector<std::wstring>& names, std::wstring query)
+    {
+        std::transform(query.begin(), query.end(), query.begin(), [](wchar_t c) { return static_cast<wchar_t>(std::towlower(c)); });
+
+        std::vector<size_t> prefix, contains;
+        for (size_t i = 0; i < names.size(); i++)
+        {
+            std::wstring name = names[i];
+            std::transform(name.begin(), name.end(), name.begin(), [](wchar_t c) { return static_cast<wchar_t>(std::towlower(c)); });
+
+            const size_t pos = name.find(query);
+            if (pos == 0)
+                prefix.push_back(i);
+            else if (pos != std::wstring::npos)
+                contains.push_back(i);
+        }
+
+        prefix.insert(prefix.end(), contains.begin(), contains.end());
+        return prefix;
+    }
+
+    double ElapsedMS(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t num_names = argc > 1 ? std::max<size_t>(1, std::strtoul(argv[1], nullptr, 10)) : 10000;
+    const std::vector<std::wstring> names = CreateNames(num_names);
+
+    SearchIndex index;
+    index.Reserve(names.size());
+    for (const auto& name : names)
+        index.AddName(name);
+
+    bool matches = true;
+    bool within_target = true;
+
+    std::cout << num_names << " names, " << REPEATS << " repeats, ms per keystroke\n";
+
+    for (const auto& query : QUERIES)
+    {
+        // Typing the query once creates the result buffers, the timed runs reuse them
+        for (const auto& character : query)
+            index.Push(character);
+        matches = index.GetMatches() == PlainSearch(names, query) && matches;
+        index.ClearQuery();
+
+        double worst_push = 0.0, total_push = 0.0, total_pop = 0.0;
+        const uint64_t allocations = GetAllocationCount();
+
+        for (size_t length = 1; length <= query.size(); length++)
+        {
+            double push_ms = 0.0;
+
+            for (int repeat = 0; repeat < REPEATS; repeat++)
+            {
+                for (size_t i = 0; i + 1 < length; i++)
+                    index.Push(query[i]);
+
+                const auto start = std::chrono::steady_clock::now();
+                index.Push(query[length - 1]);
+                push_ms += ElapsedMS(start);
+
+                const auto pop_start = std::chrono::steady_clock::now();
+                index.Pop();
+                total_pop += ElapsedMS(pop_start);
+
+                index.ClearQuery();
+            }
+
+            worst_push = std::max(worst_push, push_ms / REPEATS);
+            total_push += push_ms / REPEATS;
+        }
+
+        const uint64_t num_allocations = GetAllocationCount() - allocations;
+        within_target = within_target && worst_push < TARGET_MS;
+
+        // The queries are plain ASCII
+        const std::string label{ query.begin(), query.end() };
+        std::cout << "  \"" << label << "\"" << std::string(label.size() < 10 ? 10 - label.size() : 1, ' ')
+            << "push avg " << total_push / query.size() << ", worst " << worst_push
+            << ", pop avg " << total_pop / (query.size() * REPEATS)
+            << ", " << num_allocations << " allocations" << (worst_push < TARGET_MS ? "" : "  OVER TARGET") << "\n";
+    }
+
+    if (!matches)
+        std::cerr << "The index matches differ from a plain search\n";
+
+    return matches && within_target ? 0 : 1;
+}
@@ -0,0 +1,194 @@
+/*
+* Compares the compiled stat formulas with the hand written Attack/Defense code they replaced,
+* per Stats object and over a StatStore's columns, after checking that INT32_MIN / -1 wraps around on every path.
+* Build from the repository root:
+*   cl /std:c++20 /EHsc /O2 /DNOMINMAX /Ilibs\tinyxml2 tools\StatBenchmark\StatBenchmark.cpp source\Stats.cpp
+*      source\utility\StatFormula.cpp source\utility\StatStore.cpp source\Logger.cpp libs\tinyxml2\tinyxml2.cpp
+* Add /DTRPG_NO_SIMD to compare against the scalar batch kernel.
+* Usage: StatBenchmark [num_actors], without it 16, 1000 and 100000 actors are run
+*/
+#include "../../source/Stats.h"
+#include "../../source/utility/StatFormula.h"
+#include "../../source/utility/StatStore.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+    // Stats::UpdateStats before the formulas were data driven
+    int HandWrittenAttack(const Stats& stats)
+    {
+        return stats.GetEquipmentValue(Stats::EquipSlots::WEAPON) + stats.GetTotal(StatId::STRENGTH) +
+            (stats.GetTotal(StatId::INTELLIGENCE) / 5) +
+            (stats.GetTotal(StatId::WILLPOWER) / 5);
+    }
+
+    int HandWrittenDefense(const Stats& stats)
+    {
+        return stats.GetEquipmentValue(Stats::EquipSlots::HEADGEAR) + stats.GetEquipmentValue(Stats::EquipSlots::CHEST_BODY) +
+            stats.GetEquipmentValue(Stats::EquipSlots::FOOTWEAR) +
+            (stats.GetTotal(StatId::STRENGTH) / 5) +
+            (stats.GetTotal(StatId::INTELLIGENCE) / 5) +
+            (stats.GetTotal(StatId::SPEED) / 5) +
+            (stats.GetTotal(StatId::WILLPOWER) / 5);
+    }
+
+    // INT32_MIN / -1 overflows, each kind of divisor has to wrap it around in both evaluators instead of trapping
+    bool CheckDivideByMinusOne()
+    {
+        const char* sources[] = { "Strength / -1", "Strength / Speed", "Strength / (Speed + Intelligence)" };
+        const std::vector<int> strength{ INT_MIN, 7, -7, INT_MIN, 0, 1, INT_MIN, -1, INT_MAX };
+
+        const std::vector<int> minus_one(strength.size(), -1);
+        const std::vector<int> zero(strength.size(), 0);
+        std::vector<const int*> inputs(NUM_STAT_INPUTS, zero.data());
+        inputs[GetStatInput(StatId::STRENGTH)] = strength.data();
+        inputs[GetStatInput(StatId::SPEED)] = minus_one.data();
+
+        bool matches = true;
+        for (const char* source : sources)
+        {
+            StatFormula formula;
+            if (!formula.Compile(source))
+                return false;
+
+            std::vector<int> out(strength.size());
+            formula.EvaluateBatch(inputs.data(), strength.size(), out.data());
+
+            for (size_t i = 0; i < strength.size(); i++)
+            {
+                const int expected = strength[i] == INT_MIN ? INT_MIN : -strength[i];
+                const Stats stats{ strength[i], 0, -1, 0, 0 };
+
+                if (out[i] != expected || formula.Evaluate(stats) != expected)
+                {
+                    std::cout << "  " << source << " with Strength " << strength[i] << "  MISMATCH\n";
+                    matches = false;
+                }
+            }
+        }
+
+        return matches;
+    }
+
+    template <typename Fn>
+    double NanosecondsPerActor(size_t num_actors, int repeats, Fn&& fn)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < repeats; i++)
+            fn();
+
+        const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        return elapsed / (static_cast<double>(num_actors) * repeats);
+    }
+}
+
+static bool RunBenchmark(size_t num_actors)
+{
+    const int repeats = static_cast<int>(std::max<size_t>(1, 10'000'000 / std::max<size_t>(num_actors, 1)));
+
+    std::mt19937 random{ 1234 };
+    std::uniform_int_distribution<int> stat_value{ 0, 99 };
+
+    // One Stats per actor, and the same values in a StatStore for the batch kernels
+    std::vector<Stats> actors;
+    StatStore store;
+    actors.reserve(num_actors);
+    store.Reserve(num_actors);
+
+    for (size_t i = 0; i < num_actors; i++)
+    {
+        Stats& stats = actors.emplace_back(stat_value(random), stat_value(random), stat_value(random), stat_value(random), stat_value(random));
+
+        for (size_t slot = 0; slot < Stats::NUM_EQUIP_SLOTS; slot++)
+            stats.SetEquipmentValue(static_cast<Stats::EquipSlots>(slot), stat_value(random));
+
+        store.AddActor(stats);
+    }
+
+    std::vector<const int*> inputs;
+    for (size_t stat = 0; stat < NUM_STATS; stat++)
+        inputs.push_back(store.GetColumn(static_cast<StatId>(stat)));
+    for (size_t slot = 0; slot < Stats::NUM_EQUIP_SLOTS; slot++)
+        inputs.push_back(store.GetColumn(static_cast<Stats::EquipSlots>(slot)));
+
+    const StatFormula& attack = *StatFormulas::GetInstance().Get(StatId::ATTACK);
+    const StatFormula& defense = *StatFormulas::GetInstance().Get(StatId::DEFENSE);
+
+    std::vector<int> expected_attack(num_actors), expected_defense(num_actors);
+    std::vector<int> attack_out(num_actors), defense_out(num_actors);
+    volatile int sink = 0;
+
+    const double hand_written = NanosecondsPerActor(num_actors, repeats, [&] {
+        for (size_t i = 0; i < num_actors; i++)
+        {
+            expected_attack[i] = HandWrittenAttack(actors[i]);
+            expected_defense[i] = HandWrittenDefense(actors[i]);
+        }
+        sink = expected_attack[num_actors - 1];
+    });
+
+    const double interpreted = NanosecondsPerActor(num_actors, repeats, [&] {
+        for (size_t i = 0; i < num_actors; i++)
+        {
+            attack_out[i] = attack.Evaluate(actors[i]);
+            defense_out[i] = defense.Evaluate(actors[i]);
+        }
+        sink = attack_out[num_actors - 1];
+    });
+
+    const bool interpreted_matches = attack_out == expected_attack && defense_out == expected_defense;
+
+    const double hand_written_columns = NanosecondsPerActor(num_actors, repeats, [&] {
+        for (size_t i = 0; i < num_actors; i++)
+        {
+            attack_out[i] = inputs[GetStatInput(Stats::EquipSlots::WEAPON)][i] + inputs[GetStatInput(StatId::STRENGTH)][i] +
+                inputs[GetStatInput(StatId::INTELLIGENCE)][i] / 5 + inputs[GetStatInput(StatId::WILLPOWER)][i] / 5;
+            defense_out[i] = inputs[GetStatInput(Stats::EquipSlots::HEADGEAR)][i] + inputs[GetStatInput(Stats::EquipSlots::CHEST_BODY)][i] +
+                inputs[GetStatInput(Stats::EquipSlots::FOOTWEAR)][i] + inputs[GetStatInput(StatId::STRENGTH)][i] / 5 +
+                inputs[GetStatInput(StatId::INTELLIGENCE)][i] / 5 + inputs[GetStatInput(StatId::SPEED)][i] / 5 +
+                inputs[GetStatInput(StatId::WILLPOWER)][i] / 5;
+        }
+        sink = attack_out[num_actors - 1];
+    });
+
+    // Changing one input each time keeps both derived stats dirty, so every call evaluates them for all actors
+    const double batch = NanosecondsPerActor(num_actors, repeats, [&] {
+        store.SetStat(0, StatId::STRENGTH, store.GetStat(0, StatId::STRENGTH) ^ 1);
+        store.UpdateStats();
+        sink = store.GetStat(num_actors - 1, StatId::ATTACK);
+    });
+
+    store.SetActor(0, actors[0]);
+    const int* store_attack = store.GetColumn(StatId::ATTACK);
+    const int* store_defense = store.GetColumn(StatId::DEFENSE);
+    const bool batch_matches = std::equal(expected_attack.begin(), expected_attack.end(), store_attack) &&
+        std::equal(expected_defense.begin(), expected_defense.end(), store_defense);
+
+    std::cout << num_actors << " actors, " << repeats << " repeats, Attack + Defense per actor\n"
+        << "  hand written, per Stats    " << hand_written << " ns\n"
+        << "  bytecode, per Stats        " << interpreted << " ns" << (interpreted_matches ? "" : "  MISMATCH") << "\n"
+        << "  hand written, columns      " << hand_written_columns << " ns\n"
+        << "  StatStore batch, columns   " << batch << " ns" << (batch_matches ? "" : "  MISMATCH") << "\n";
+
+    return interpreted_matches && batch_matches;
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<size_t> sizes{ 16, 1000, 100000 };
+    if (argc > 1)
+        sizes = { std::max<size_t>(1, std::strtoul(argv[1], nullptr, 10)) };
+
+    bool matches = CheckDivideByMinusOne();
+    for (size_t num_actors : sizes)
+        matches = RunBenchmark(num_actors) && matches;
+
+    return matches ? 0 : 1;
+}